@@ -0,0 +1,115 @@
+#include "BallScheduler.hpp"
+
+#include "PongMode.hpp"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+bool BallScheduler::matches(PongMode const &pong, float speed_) const {
+	if (!valid) return false;
+	if (speed_ != speed) return false;
+	if (generations.size() != pong.balls.size()) return false;
+	if (court_radius != pong.court_radius || paddle_radius != pong.paddle_radius) return false;
+	if (ball_radius != pong.ball_radius || block_radius != pong.block_radius) return false;
+	if (paddle_x != glm::vec2(pong.left_paddle.x, pong.right_paddle.x)) return false;
+	if (blocks.size() != pong.blocks.size()) return false;
+	for (uint32_t b = 0; b < blocks.size(); ++b) {
+		if (blocks[b] != pong.blocks[b].pos) return false;
+	}
+	return true;
+}
+
+void BallScheduler::rebuild(PongMode const &pong, float speed_) {
+	valid = true;
+	speed = speed_;
+	court_radius = pong.court_radius;
+	paddle_radius = pong.paddle_radius;
+	ball_radius = pong.ball_radius;
+	block_radius = pong.block_radius;
+	paddle_x = glm::vec2(pong.left_paddle.x, pong.right_paddle.x);
+	blocks.clear();
+	for (auto const &block : pong.blocks) {
+		blocks.emplace_back(block.pos);
+	}
+
+	now = 0.0;
+	queue = decltype(queue)();
+	generations.assign(pong.balls.size(), 0);
+	awake_flags.assign(pong.balls.size(), 0);
+	in_slab.clear();
+	for (uint32_t i = 0; i < pong.balls.size(); ++i) {
+		schedule(pong, i);
+	}
+}
+
+void BallScheduler::schedule(PongMode const &pong, uint32_t i) {
+	generations[i] += 1;
+
+	glm::vec2 const &at = pong.balls[i];
+	glm::vec2 velocity = speed * pong.ball_velocities[i];
+
+	//paddle slabs: x range from which the ball could touch the paddle at some y:
+	float time = horizon;
+	float reach = paddle_radius.x + ball_radius.x;
+	for (float x : { paddle_x[0], paddle_x[1] }) {
+		float offset = at.x - x;
+		if (std::abs(offset) < reach) {
+			in_slab.emplace_back(i);
+			return;
+		}
+		//time to reach the near edge of the slab (if heading toward it):
+		if (offset * velocity.x < 0.0f) {
+			time = std::min(time, (std::abs(offset) - reach) / std::abs(velocity.x));
+		}
+	}
+
+	//walls and blocks (static, so the prediction holds until something changes):
+	PongMode::Hit hit = pong.sweep(at, velocity * time, PongMode::Hit(), false);
+	if (hit.kind != PongMode::Hit::None) time *= hit.time;
+
+	queue.emplace(Event{now + time, i, generations[i]});
+}
+
+void BallScheduler::step(PongMode &pong, float speed_, float elapsed, uint32_t *left_scored, uint32_t *right_scored) {
+	if (!matches(pong, speed_)) rebuild(pong, speed_);
+
+	double end = now + elapsed;
+
+	//wake balls in a slab and balls whose event falls within this step:
+	awake.clear();
+	for (uint32_t i : in_slab) {
+		awake_flags[i] = 1;
+		awake.emplace_back(i);
+	}
+	in_slab.clear();
+	while (!queue.empty() && queue.top().time <= end + slack) {
+		Event event = queue.top();
+		queue.pop();
+		if (event.generation != generations[event.ball]) continue;
+		if (awake_flags[event.ball]) continue;
+		awake_flags[event.ball] = 1;
+		awake.emplace_back(event.ball);
+	}
+	last_awake = uint32_t(awake.size());
+
+	//everyone else just moves (in bulk, so awake balls are put back afterward):
+	float scale = elapsed * speed;
+	awake_from.clear();
+	for (uint32_t i : awake) {
+		awake_from.emplace_back(pong.balls[i]);
+	}
+	integrate_balls(pong.balls.data(), pong.ball_velocities.data(), uint32_t(pong.balls.size()), scale);
+	for (uint32_t a = 0; a < awake.size(); ++a) {
+		pong.balls[awake[a]] = awake_from[a];
+	}
+
+	//awake balls move with full collision handling, then get a new prediction:
+	now = end;
+	for (uint32_t i : awake) {
+		pong.move_ball(i, scale, left_scored, right_scored);
+		awake_flags[i] = 0;
+		schedule(pong, i);
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+struct PongMode;
+
+/*
+ * BallScheduler is an event-driven alternative to sweeping every ball
+ *  against everything every step.
+ *
+ * Between bounces a ball moves in a straight line, so the time of its next
+ *  wall or block hit can be computed once and kept in a priority queue.
+ * Paddles move, so instead of predicting paddle hits the scheduler predicts
+ *  when a ball enters a paddle's "slab" (the strip of x values from which it
+ *  could touch the paddle at any y); balls inside a slab are swept normally
+ *  every step. Paddle movement therefore never invalidates a prediction.
+ *
+ * Each step, balls whose events fall within the step (plus balls inside a
+ *  slab) go through PongMode::move_ball; everything else just advances along
+ *  its velocity. Between rebuilds, collision cost is O(events) rather than
+ *  O(balls * objects).
+ *
+ * Predictions are rebuilt from scratch when anything they depend on changes:
+ *  ball count, speed, court/paddle/ball/block sizes, paddle x, or blocks.
+ *  A rebuild sweeps every ball against every wall and block, i.e. it costs
+ *  about as much as one step of the plain per-ball sweep. Every block hit
+ *  removes the block (and split blocks add balls), so in play with many
+ *  blocks rebuilds are frequent and the saving is smaller than O(events).
+ */
+
+struct BallScheduler {
+	//force a full rebuild on the next step (e.g., after loading a snapshot):
+	void invalidate() { valid = false; }
+
+	//advance all balls by 'elapsed' seconds at 'speed' times their velocity:
+	void step(PongMode &pong, float speed, float elapsed, uint32_t *left_scored, uint32_t *right_scored);
+
+	//predictions look at most this far ahead (seconds); balls with nothing sooner get re-checked then:
+	float horizon = 4.0f;
+
+	//events this close after the end of a step (seconds) are handled in that step,
+	// so rounding in predicted times never lets a ball drift past a contact:
+	double slack = 1e-3;
+
+	//balls tested for collisions in the last step (for comparison with the ball count):
+	uint32_t last_awake = 0;
+
+	//---- internals ----
+	struct Event {
+		double time;
+		uint32_t ball;
+		uint32_t generation; //stale if it doesn't match generations[ball]
+		bool operator>(Event const &other) const { return time > other.time; }
+	};
+	std::priority_queue< Event, std::vector< Event >, std::greater< Event > > queue;
+	std::vector< uint32_t > generations; //per ball
+	std::vector< uint8_t > awake_flags; //per ball, scratch
+	std::vector< uint32_t > awake; //balls to sweep this step
+	std::vector< glm::vec2 > awake_from; //positions of 'awake' balls at the start of the step
+	std::vector< uint32_t > in_slab; //balls inside a paddle slab (swept every step)
+	double now = 0.0;
+
+	//what the predictions were made against:
+	bool valid = false;
+	float speed = 0.0f;
+	glm::vec2 court_radius = glm::vec2(0.0f);
+	glm::vec2 paddle_radius = glm::vec2(0.0f);
+	glm::vec2 ball_radius = glm::vec2(0.0f);
+	glm::vec2 block_radius = glm::vec2(0.0f);
+	glm::vec2 paddle_x = glm::vec2(0.0f); //left, right
+	std::vector< glm::vec2 > blocks;
+
+	bool matches(PongMode const &pong, float speed) const;
+	void rebuild(PongMode const &pong, float speed);
+	void schedule(PongMode const &pong, uint32_t ball); //predict ball's next event after 'now'
+};
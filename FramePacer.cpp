@@ -0,0 +1,109 @@
+#include "FramePacer.hpp"
+
+#include "Profiler.hpp"
+#include "log.hpp"
+
+#include <cstdlib>
+#include <thread>
+
+constexpr std::chrono::microseconds FramePacer::SpinMargin;
+
+bool FramePacer::parse(std::string const &spec, Mode *mode_, float *cap_hz_) {
+	if (spec == "vsync") *mode_ = Mode::Vsync;
+	else if (spec == "adaptive") *mode_ = Mode::Adaptive;
+	else if (spec == "uncapped") *mode_ = Mode::Uncapped;
+	else if (spec.compare(0, 4, "cap:") == 0) {
+		char *end = nullptr;
+		float hz = std::strtof(spec.c_str() + 4, &end);
+		if (end == spec.c_str() + 4 || *end != '\0' || !(hz > 0.0f)) return false;
+		*mode_ = Mode::Cap;
+		*cap_hz_ = hz;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+void FramePacer::set(Mode mode_, float cap_hz_) {
+	mode = mode_;
+	if (cap_hz_ > 0.0f) cap_hz = cap_hz_;
+	fallback = false;
+	next_start = Clock::now();
+
+	int interval = 0;
+	if (mode == Mode::Vsync) interval = 1;
+	else if (mode == Mode::Adaptive) interval = -1;
+
+	if (SDL_GL_SetSwapInterval(interval) != 0) {
+		if (interval == -1) {
+			LOG_WARNING("couldn't set vsync + late swap tearing (" << SDL_GetError() << ").");
+			fallback = true;
+			if (SDL_GL_SetSwapInterval(1) != 0) {
+				LOG_WARNING("couldn't set vsync (" << SDL_GetError() << ").");
+			}
+		} else {
+			LOG_WARNING("couldn't set swap interval " << interval << " (" << SDL_GetError() << ").");
+		}
+	}
+	LOG_INFO("Frame pacing: " << describe() << ".");
+}
+
+void FramePacer::cycle() {
+	switch (mode) {
+		case Mode::Vsync: set(Mode::Adaptive); break;
+		case Mode::Adaptive: set(Mode::Cap); break;
+		case Mode::Cap: set(Mode::Uncapped); break;
+		case Mode::Uncapped: set(Mode::Vsync); break;
+	}
+}
+
+std::string FramePacer::describe() const {
+	switch (mode) {
+		case Mode::Vsync: return "vsync";
+		case Mode::Adaptive: return (fallback ? "adaptive (unsupported; using vsync)" : "adaptive");
+		case Mode::Cap: return "cap:" + std::to_string(int32_t(cap_hz + 0.5f));
+		case Mode::Uncapped: return "uncapped";
+	}
+	return "unknown";
+}
+
+void FramePacer::wait() {
+	if (mode != Mode::Cap) return;
+	PROFILE_ZONE("pace");
+
+	auto period = std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(1.0 / cap_hz));
+	auto now = Clock::now();
+	if (now < next_start) {
+		if (next_start - now > SpinMargin) {
+			std::this_thread::sleep_for(next_start - now - SpinMargin);
+		}
+		while (Clock::now() < next_start) {
+			//spin
+		}
+		next_start += period;
+	} else {
+		//running behind (or just started): pace from now rather than trying to catch up:
+		next_start = now + period;
+	}
+}
+
+void FramePacer::input() {
+	if (!have_input) {
+		input_counter = SDL_GetPerformanceCounter();
+		have_input = true;
+	}
+}
+
+void FramePacer::input_sampled(uint64_t counter) {
+	input_counter = counter;
+	have_input = true;
+}
+
+void FramePacer::swap(SDL_Window *window) {
+	SDL_GL_SwapWindow(window);
+	if (have_input) {
+		uint64_t ticks = SDL_GetPerformanceCounter() - input_counter;
+		profiler.record("input.latency", uint64_t(double(ticks) * 1e9 / double(SDL_GetPerformanceFrequency())));
+		have_input = false;
+	}
+}
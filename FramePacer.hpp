@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/*
+ * FramePacer decides when frames start and how they are presented:
+ *
+ *  vsync    -- swap interval 1: wait for vertical blank.
+ *  adaptive -- swap interval -1 (late swaps tear instead of waiting a whole
+ *              refresh); falls back to vsync if the driver refuses.
+ *  cap:N    -- swap interval 0, and wait() holds each frame's start to N Hz:
+ *              sleep until a little before the deadline, then spin (sleep
+ *              alone overshoots by up to a scheduler tick). Waiting *before*
+ *              input and simulation keeps the input-to-swap time short.
+ *  uncapped -- swap interval 0, no waiting.
+ *
+ * It also measures an input-to-photon proxy: the time from when the frame's
+ *  first input event is taken from SDL's queue to the return of that frame's
+ *  swap, reported to the profiler as the "input.latency" zone.
+ *  (Measured with SDL_GetPerformanceCounter(); SDL event timestamps and
+ *  SDL_GetTicks() are whole milliseconds, too coarse to tell the modes apart.)
+ */
+
+struct FramePacer {
+	enum class Mode {
+		Vsync,
+		Adaptive,
+		Cap,
+		Uncapped,
+	};
+
+	//parse "vsync", "adaptive", "cap:<hz>", or "uncapped"; returns false if 'spec' is none of those:
+	static bool parse(std::string const &spec, Mode *mode, float *cap_hz);
+
+	//switch modes (needs a current GL context for the swap interval):
+	void set(Mode mode, float cap_hz = 0.0f);
+	//next mode in the list above (for the F7 key), keeping cap_hz:
+	void cycle();
+
+	//e.g. "cap:120" or "adaptive (unsupported; using vsync)":
+	std::string describe() const;
+
+	//call at the top of each frame (before polling events):
+	void wait();
+
+	//call for each input event handled this frame (the first one starts the clock):
+	void input();
+	//call when the input a frame shows was re-read after the event step (e.g., PongMode::late_mouse);
+	// the clock restarts from 'counter' (an SDL_GetPerformanceCounter() value):
+	void input_sampled(uint64_t counter);
+
+	//present the frame and record latency:
+	void swap(SDL_Window *window);
+
+	Mode mode = Mode::Adaptive;
+	float cap_hz = 120.0f;
+	bool fallback = false; //adaptive wasn't available (running as vsync)
+
+	//---- internals ----
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point next_start; //cap mode: when the next frame may start
+	bool have_input = false;
+	uint64_t input_counter = 0; //SDL_GetPerformanceCounter() at the first input
+
+	//cap mode sleeps until this long before the deadline, then spins:
+	static constexpr std::chrono::microseconds SpinMargin = std::chrono::microseconds(1500);
+};
@@ -3,18 +3,98 @@
 #include <SDL.h>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <unordered_set>
 
-#ifdef _WIN32
-	#define DO(fn) \
-		fn = (decltype(fn))SDL_GL_GetProcAddress(#fn); \
-		if (!fn) { \
-			throw std::runtime_error("Error binding " #fn); \
-		}
+GLDispatch gl_dispatch;
+GLExtensions gl_extensions;
+
+//core entry points: every one with the dispatch table, 1.2+ on Windows otherwise
+// (with the table, 'fn' expands to its gl_dispatch entry, so the name is stringized
+//  before 'fn' is passed on -- '#fn' inside BIND would see the expansion):
+#define BIND(fn, name) \
+	fn = (decltype(fn))SDL_GL_GetProcAddress(name); \
+	if (!fn) { \
+		throw std::runtime_error("Error binding " name); \
+	}
+#if defined(GL_DISPATCH_TABLE) || defined(_WIN32)
+	#define DO(fn) BIND(fn, #fn)
 #else
 	#define DO(fn)
 #endif
+#ifdef GL_DISPATCH_TABLE
+	#define DO_1_1(fn) BIND(fn, #fn)
+#else
+	#define DO_1_1(fn)
+#endif
+
+//extension entry points (allowed to be missing; 'fn' always expands to its gl_dispatch entry):
+#define EXT(fn) \
+	fn = (decltype(fn))SDL_GL_GetProcAddress(#fn);
 
 void init_GL() {
+	DO_1_1(glCullFace)
+	DO_1_1(glFrontFace)
+	DO_1_1(glHint)
+	DO_1_1(glLineWidth)
+	DO_1_1(glPointSize)
+	DO_1_1(glPolygonMode)
+	DO_1_1(glScissor)
+	DO_1_1(glTexParameterf)
+	DO_1_1(glTexParameterfv)
+	DO_1_1(glTexParameteri)
+	DO_1_1(glTexParameteriv)
+	DO_1_1(glTexImage1D)
+	DO_1_1(glTexImage2D)
+	DO_1_1(glDrawBuffer)
+	DO_1_1(glClear)
+	DO_1_1(glClearColor)
+	DO_1_1(glClearStencil)
+	DO_1_1(glClearDepth)
+	DO_1_1(glStencilMask)
+	DO_1_1(glColorMask)
+	DO_1_1(glDepthMask)
+	DO_1_1(glDisable)
+	DO_1_1(glEnable)
+	DO_1_1(glFinish)
+	DO_1_1(glFlush)
+	DO_1_1(glBlendFunc)
+	DO_1_1(glLogicOp)
+	DO_1_1(glStencilFunc)
+	DO_1_1(glStencilOp)
+	DO_1_1(glDepthFunc)
+	DO_1_1(glPixelStoref)
+	DO_1_1(glPixelStorei)
+	DO_1_1(glReadBuffer)
+	DO_1_1(glReadPixels)
+	DO_1_1(glGetBooleanv)
+	DO_1_1(glGetDoublev)
+	DO_1_1(glGetError)
+	DO_1_1(glGetFloatv)
+	DO_1_1(glGetIntegerv)
+	DO_1_1(glGetString)
+	DO_1_1(glGetTexImage)
+	DO_1_1(glGetTexParameterfv)
+	DO_1_1(glGetTexParameteriv)
+	DO_1_1(glGetTexLevelParameterfv)
+	DO_1_1(glGetTexLevelParameteriv)
+	DO_1_1(glIsEnabled)
+	DO_1_1(glDepthRange)
+	DO_1_1(glViewport)
+	DO_1_1(glDrawArrays)
+	DO_1_1(glDrawElements)
+	DO_1_1(glGetPointerv)
+	DO_1_1(glPolygonOffset)
+	DO_1_1(glCopyTexImage1D)
+	DO_1_1(glCopyTexImage2D)
+	DO_1_1(glCopyTexSubImage1D)
+	DO_1_1(glCopyTexSubImage2D)
+	DO_1_1(glTexSubImage1D)
+	DO_1_1(glTexSubImage2D)
+	DO_1_1(glBindTexture)
+	DO_1_1(glDeleteTextures)
+	DO_1_1(glGenTextures)
+	DO_1_1(glIsTexture)
 	DO(glDrawRangeElements)
 	DO(glTexImage3D)
 	DO(glTexSubImage3D)
@@ -298,8 +378,55 @@ void init_GL() {
 	DO(glVertexAttribP3uiv)
 	DO(glVertexAttribP4ui)
 	DO(glVertexAttribP4uiv)
+
+	//extensions -- listed once, checked once:
+	std::unordered_set< std::string > available;
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (GLint i = 0; i < count; ++i) {
+		if (GLubyte const *name = glGetStringi(GL_EXTENSIONS, GLuint(i))) {
+			available.emplace(reinterpret_cast< char const * >(name));
+		}
+	}
+	if (available.count("GL_ARB_buffer_storage")) {
+		EXT(glBufferStorage)
+		gl_extensions.ARB_buffer_storage = (glBufferStorage != nullptr);
+	}
+	if (available.count("GL_KHR_debug")) {
+		EXT(glDebugMessageControl)
+		EXT(glDebugMessageInsert)
+		EXT(glDebugMessageCallback)
+		EXT(glGetDebugMessageLog)
+		EXT(glPushDebugGroup)
+		EXT(glPopDebugGroup)
+		EXT(glObjectLabel)
+		EXT(glGetObjectLabel)
+		EXT(glObjectPtrLabel)
+		EXT(glGetObjectPtrLabel)
+		gl_extensions.KHR_debug = (glDebugMessageControl != nullptr) && (glDebugMessageInsert != nullptr) && (glDebugMessageCallback != nullptr) && (glGetDebugMessageLog != nullptr) && (glPushDebugGroup != nullptr) && (glPopDebugGroup != nullptr) && (glObjectLabel != nullptr) && (glGetObjectLabel != nullptr) && (glObjectPtrLabel != nullptr) && (glGetObjectPtrLabel != nullptr);
+	}
+	if (available.count("GL_KHR_parallel_shader_compile")) {
+		EXT(glMaxShaderCompilerThreadsKHR)
+		gl_extensions.KHR_parallel_shader_compile = (glMaxShaderCompilerThreadsKHR != nullptr);
+	}
+	if (available.count("GL_ARB_get_program_binary")) {
+		EXT(glGetProgramBinary)
+		EXT(glProgramBinary)
+		EXT(glProgramParameteri)
+		gl_extensions.ARB_get_program_binary = (glGetProgramBinary != nullptr) && (glProgramBinary != nullptr) && (glProgramParameteri != nullptr);
+	}
+	if (available.count("GL_ARB_draw_indirect")) {
+		EXT(glDrawArraysIndirect)
+		EXT(glDrawElementsIndirect)
+		gl_extensions.ARB_draw_indirect = (glDrawArraysIndirect != nullptr) && (glDrawElementsIndirect != nullptr);
+	}
+	if (available.count("GL_ARB_multi_draw_indirect")) {
+		EXT(glMultiDrawArraysIndirect)
+		EXT(glMultiDrawElementsIndirect)
+		gl_extensions.ARB_multi_draw_indirect = (glMultiDrawArraysIndirect != nullptr) && (glMultiDrawElementsIndirect != nullptr);
+	}
 }
-#ifdef _WIN32
+#if defined(_WIN32) && !defined(GL_DISPATCH_TABLE)
 	 void (APIENTRYFP glDrawRangeElements) (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices);
 	 void (APIENTRYFP glTexImage3D) (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels);
 	 void (APIENTRYFP glTexSubImage3D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels);
@@ -2,16 +2,28 @@
 
 /*
  *
- * Function prototypes/pointers for OpenGL 3.3 core, with minimal namespace pollution.
+ * Function prototypes/pointers for OpenGL 3.3 core, plus a few extensions,
+ *  with minimal namespace pollution.
  * Call init_GL() after you have created a context.
  *
- * On Windows, OpenGL 1.0 & 1.1 are prototypes, the rest are pointers
- *  initialized by init_GL(). This is because the 1.1/1.0 entries are
- *  the only ones provided directly by OpenGL32.dll 
+ * By default (GL_DISPATCH_TABLE), every entry point -- on every platform -- is
+ *  a function pointer in the gl_dispatch table, loaded by init_GL() through
+ *  SDL_GL_GetProcAddress; the gl* names are macros that call through it. The
+ *  calls used every frame come first in the table, so they share a few cache
+ *  lines.
  *
- * On Linux, all are prototypes.
+ * Building with GL_PROTOTYPES defined instead uses the old arrangement:
+ *  on Windows, OpenGL 1.0 & 1.1 are prototypes, the rest are pointers
+ *  initialized by init_GL() (because the 1.1/1.0 entries are the only ones
+ *  provided directly by OpenGL32.dll); on Linux and MacOS, all are prototypes.
  *
- * On MacOS, all are prototypes.
+ * Either way, extension functions (see the end of this file) are always
+ *  table entries, null unless the driver has them; check gl_extensions
+ *  (filled in once, by init_GL()) before calling them.
+ *
+ * NOTE: the table belongs to the context that was current for init_GL().
+ *  (Only Windows can hand out different pointers for different contexts;
+ *  call init_GL() again after switching to one made with other settings.)
  *
  * This file has been automatically generated from glcorearb.h by make-GL.py
  *
@@ -19,6 +31,10 @@
 
 void init_GL(); //will throw on failure.
 
+#if !defined(GL_PROTOTYPES) && !defined(GL_DISPATCH_TABLE)
+#define GL_DISPATCH_TABLE 1
+#endif
+
 extern "C" {
 
 #include <stdint.h>
@@ -30,6 +46,7 @@ extern "C" {
 	#define APIENTRY
 	#define APIENTRYFP
 #endif
+#define APIENTRYP APIENTRY * //(dispatch table entries are always pointers)
 
 //this is how khronos_ssize_t gets defined in khrplatform.h:
 #ifdef _WIN64
@@ -1276,4 +1293,824 @@ GLAPI void (APIENTRYFP glVertexAttribP3uiv) (GLuint index, GLenum type, GLboolea
 GLAPI void (APIENTRYFP glVertexAttribP4ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
 GLAPI void (APIENTRYFP glVertexAttribP4uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
 
+// ---- extensions ----
+
+// GL_ARB_buffer_storage:
+#define GL_ARB_buffer_storage 1
+#define GL_MAP_PERSISTENT_BIT             0x0040
+#define GL_MAP_COHERENT_BIT               0x0080
+#define GL_DYNAMIC_STORAGE_BIT            0x0100
+#define GL_CLIENT_STORAGE_BIT             0x0200
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
+#define GL_BUFFER_IMMUTABLE_STORAGE       0x821F
+#define GL_BUFFER_STORAGE_FLAGS           0x8220
+
+// GL_KHR_debug:
+#define GL_KHR_debug 1
+typedef void (APIENTRY  *GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLenum severity,GLsizei length,const GLchar *message,const void *userParam);
+#define GL_DEBUG_CALLBACK_FUNCTION        0x8244
+#define GL_DEBUG_CALLBACK_USER_PARAM      0x8245
+#define GL_DEBUG_GROUP_STACK_DEPTH        0x826D
+#define GL_DEBUG_LOGGED_MESSAGES          0x9145
+#define GL_DEBUG_NEXT_LOGGED_MESSAGE_LENGTH 0x8243
+#define GL_DEBUG_OUTPUT                   0x92E0
+#define GL_DEBUG_OUTPUT_SYNCHRONOUS       0x8242
+#define GL_DEBUG_SEVERITY_HIGH            0x9146
+#define GL_DEBUG_SEVERITY_LOW             0x9148
+#define GL_DEBUG_SEVERITY_MEDIUM          0x9147
+#define GL_DEBUG_SEVERITY_NOTIFICATION    0x826B
+#define GL_DEBUG_SOURCE_API               0x8246
+#define GL_DEBUG_SOURCE_APPLICATION       0x824A
+#define GL_DEBUG_SOURCE_OTHER             0x824B
+#define GL_DEBUG_SOURCE_SHADER_COMPILER   0x8248
+#define GL_DEBUG_SOURCE_THIRD_PARTY       0x8249
+#define GL_DEBUG_SOURCE_WINDOW_SYSTEM     0x8247
+#define GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR 0x824D
+#define GL_DEBUG_TYPE_ERROR               0x824C
+#define GL_DEBUG_TYPE_MARKER              0x8268
+#define GL_DEBUG_TYPE_OTHER               0x8251
+#define GL_DEBUG_TYPE_PERFORMANCE         0x8250
+#define GL_DEBUG_TYPE_POP_GROUP           0x826A
+#define GL_DEBUG_TYPE_PORTABILITY         0x824F
+#define GL_DEBUG_TYPE_PUSH_GROUP          0x8269
+#define GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR  0x824E
+#define GL_MAX_DEBUG_GROUP_STACK_DEPTH    0x826C
+#define GL_MAX_DEBUG_LOGGED_MESSAGES      0x9144
+#define GL_MAX_DEBUG_MESSAGE_LENGTH       0x9143
+#define GL_MAX_LABEL_LENGTH               0x82E8
+#define GL_CONTEXT_FLAG_DEBUG_BIT         0x00000002
+
+// GL_KHR_parallel_shader_compile:
+#define GL_KHR_parallel_shader_compile 1
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR          0x91B1
+
+// GL_ARB_get_program_binary:
+#define GL_ARB_get_program_binary 1
+#define GL_PROGRAM_BINARY_FORMATS         0x87FF
+#define GL_PROGRAM_BINARY_LENGTH          0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_NUM_PROGRAM_BINARY_FORMATS     0x87FE
+
+// GL_ARB_draw_indirect:
+#define GL_ARB_draw_indirect 1
+#define GL_DRAW_INDIRECT_BUFFER           0x8F3F
+#define GL_DRAW_INDIRECT_BUFFER_BINDING   0x8F43
+
+// GL_ARB_multi_draw_indirect:
+#define GL_ARB_multi_draw_indirect 1
+
 }
+
+//---- dispatch table ----
+
+struct GLDispatch {
+	//per-frame calls:
+	void (APIENTRYP glDrawElementsBaseVertex) (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+	void (APIENTRYP glDrawElements) (GLenum mode, GLsizei count, GLenum type, const void *indices);
+	void (APIENTRYP glDrawArrays) (GLenum mode, GLint first, GLsizei count);
+	void (APIENTRYP glUseProgram) (GLuint program);
+	void (APIENTRYP glBindVertexArray) (GLuint array);
+	void (APIENTRYP glBindBuffer) (GLenum target, GLuint buffer);
+	void (APIENTRYP glBindTexture) (GLenum target, GLuint texture);
+	void (APIENTRYP glActiveTexture) (GLenum texture);
+	void (APIENTRYP glBufferData) (GLenum target, GLsizeiptr size, const void *data, GLenum usage);
+	void (APIENTRYP glBufferSubData) (GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+	void (APIENTRYP glUniformMatrix4fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glEnable) (GLenum cap);
+	void (APIENTRYP glDisable) (GLenum cap);
+	void (APIENTRYP glBlendFunc) (GLenum sfactor, GLenum dfactor);
+	void (APIENTRYP glClearColor) (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+	void (APIENTRYP glClear) (GLbitfield mask);
+	void (APIENTRYP glViewport) (GLint x, GLint y, GLsizei width, GLsizei height);
+	void (APIENTRYP glBeginQuery) (GLenum target, GLuint id);
+	void (APIENTRYP glEndQuery) (GLenum target);
+	void (APIENTRYP glGetQueryObjectuiv) (GLuint id, GLenum pname, GLuint *params);
+	void (APIENTRYP glGetQueryObjectui64v) (GLuint id, GLenum pname, GLuint64 *params);
+	GLenum (APIENTRYP glGetError) (void);
+	void (APIENTRYP glBindFramebuffer) (GLenum target, GLuint framebuffer);
+
+	//the rest of core 3.3:
+	void (APIENTRYP glCullFace) (GLenum mode);
+	void (APIENTRYP glFrontFace) (GLenum mode);
+	void (APIENTRYP glHint) (GLenum target, GLenum mode);
+	void (APIENTRYP glLineWidth) (GLfloat width);
+	void (APIENTRYP glPointSize) (GLfloat size);
+	void (APIENTRYP glPolygonMode) (GLenum face, GLenum mode);
+	void (APIENTRYP glScissor) (GLint x, GLint y, GLsizei width, GLsizei height);
+	void (APIENTRYP glTexParameterf) (GLenum target, GLenum pname, GLfloat param);
+	void (APIENTRYP glTexParameterfv) (GLenum target, GLenum pname, const GLfloat *params);
+	void (APIENTRYP glTexParameteri) (GLenum target, GLenum pname, GLint param);
+	void (APIENTRYP glTexParameteriv) (GLenum target, GLenum pname, const GLint *params);
+	void (APIENTRYP glTexImage1D) (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels);
+	void (APIENTRYP glTexImage2D) (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels);
+	void (APIENTRYP glDrawBuffer) (GLenum buf);
+	void (APIENTRYP glClearStencil) (GLint s);
+	void (APIENTRYP glClearDepth) (GLdouble depth);
+	void (APIENTRYP glStencilMask) (GLuint mask);
+	void (APIENTRYP glColorMask) (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+	void (APIENTRYP glDepthMask) (GLboolean flag);
+	void (APIENTRYP glFinish) (void);
+	void (APIENTRYP glFlush) (void);
+	void (APIENTRYP glLogicOp) (GLenum opcode);
+	void (APIENTRYP glStencilFunc) (GLenum func, GLint ref, GLuint mask);
+	void (APIENTRYP glStencilOp) (GLenum fail, GLenum zfail, GLenum zpass);
+	void (APIENTRYP glDepthFunc) (GLenum func);
+	void (APIENTRYP glPixelStoref) (GLenum pname, GLfloat param);
+	void (APIENTRYP glPixelStorei) (GLenum pname, GLint param);
+	void (APIENTRYP glReadBuffer) (GLenum src);
+	void (APIENTRYP glReadPixels) (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels);
+	void (APIENTRYP glGetBooleanv) (GLenum pname, GLboolean *data);
+	void (APIENTRYP glGetDoublev) (GLenum pname, GLdouble *data);
+	void (APIENTRYP glGetFloatv) (GLenum pname, GLfloat *data);
+	void (APIENTRYP glGetIntegerv) (GLenum pname, GLint *data);
+	const GLubyte * (APIENTRYP glGetString) (GLenum name);
+	void (APIENTRYP glGetTexImage) (GLenum target, GLint level, GLenum format, GLenum type, void *pixels);
+	void (APIENTRYP glGetTexParameterfv) (GLenum target, GLenum pname, GLfloat *params);
+	void (APIENTRYP glGetTexParameteriv) (GLenum target, GLenum pname, GLint *params);
+	void (APIENTRYP glGetTexLevelParameterfv) (GLenum target, GLint level, GLenum pname, GLfloat *params);
+	void (APIENTRYP glGetTexLevelParameteriv) (GLenum target, GLint level, GLenum pname, GLint *params);
+	GLboolean (APIENTRYP glIsEnabled) (GLenum cap);
+	void (APIENTRYP glDepthRange) (GLdouble n, GLdouble f);
+	void (APIENTRYP glGetPointerv) (GLenum pname, void **params);
+	void (APIENTRYP glPolygonOffset) (GLfloat factor, GLfloat units);
+	void (APIENTRYP glCopyTexImage1D) (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border);
+	void (APIENTRYP glCopyTexImage2D) (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
+	void (APIENTRYP glCopyTexSubImage1D) (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width);
+	void (APIENTRYP glCopyTexSubImage2D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+	void (APIENTRYP glTexSubImage1D) (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels);
+	void (APIENTRYP glTexSubImage2D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels);
+	void (APIENTRYP glDeleteTextures) (GLsizei n, const GLuint *textures);
+	void (APIENTRYP glGenTextures) (GLsizei n, GLuint *textures);
+	GLboolean (APIENTRYP glIsTexture) (GLuint texture);
+	void (APIENTRYP glDrawRangeElements) (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices);
+	void (APIENTRYP glTexImage3D) (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels);
+	void (APIENTRYP glTexSubImage3D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels);
+	void (APIENTRYP glCopyTexSubImage3D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+	void (APIENTRYP glSampleCoverage) (GLfloat value, GLboolean invert);
+	void (APIENTRYP glCompressedTexImage3D) (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data);
+	void (APIENTRYP glCompressedTexImage2D) (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data);
+	void (APIENTRYP glCompressedTexImage1D) (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data);
+	void (APIENTRYP glCompressedTexSubImage3D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data);
+	void (APIENTRYP glCompressedTexSubImage2D) (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data);
+	void (APIENTRYP glCompressedTexSubImage1D) (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data);
+	void (APIENTRYP glGetCompressedTexImage) (GLenum target, GLint level, void *img);
+	void (APIENTRYP glBlendFuncSeparate) (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
+	void (APIENTRYP glMultiDrawArrays) (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount);
+	void (APIENTRYP glMultiDrawElements) (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount);
+	void (APIENTRYP glPointParameterf) (GLenum pname, GLfloat param);
+	void (APIENTRYP glPointParameterfv) (GLenum pname, const GLfloat *params);
+	void (APIENTRYP glPointParameteri) (GLenum pname, GLint param);
+	void (APIENTRYP glPointParameteriv) (GLenum pname, const GLint *params);
+	void (APIENTRYP glBlendColor) (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+	void (APIENTRYP glBlendEquation) (GLenum mode);
+	void (APIENTRYP glGenQueries) (GLsizei n, GLuint *ids);
+	void (APIENTRYP glDeleteQueries) (GLsizei n, const GLuint *ids);
+	GLboolean (APIENTRYP glIsQuery) (GLuint id);
+	void (APIENTRYP glGetQueryiv) (GLenum target, GLenum pname, GLint *params);
+	void (APIENTRYP glGetQueryObjectiv) (GLuint id, GLenum pname, GLint *params);
+	void (APIENTRYP glDeleteBuffers) (GLsizei n, const GLuint *buffers);
+	void (APIENTRYP glGenBuffers) (GLsizei n, GLuint *buffers);
+	GLboolean (APIENTRYP glIsBuffer) (GLuint buffer);
+	void (APIENTRYP glGetBufferSubData) (GLenum target, GLintptr offset, GLsizeiptr size, void *data);
+	void * (APIENTRYP glMapBuffer) (GLenum target, GLenum access);
+	GLboolean (APIENTRYP glUnmapBuffer) (GLenum target);
+	void (APIENTRYP glGetBufferParameteriv) (GLenum target, GLenum pname, GLint *params);
+	void (APIENTRYP glGetBufferPointerv) (GLenum target, GLenum pname, void **params);
+	void (APIENTRYP glBlendEquationSeparate) (GLenum modeRGB, GLenum modeAlpha);
+	void (APIENTRYP glDrawBuffers) (GLsizei n, const GLenum *bufs);
+	void (APIENTRYP glStencilOpSeparate) (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+	void (APIENTRYP glStencilFuncSeparate) (GLenum face, GLenum func, GLint ref, GLuint mask);
+	void (APIENTRYP glStencilMaskSeparate) (GLenum face, GLuint mask);
+	void (APIENTRYP glAttachShader) (GLuint program, GLuint shader);
+	void (APIENTRYP glBindAttribLocation) (GLuint program, GLuint index, const GLchar *name);
+	void (APIENTRYP glCompileShader) (GLuint shader);
+	GLuint (APIENTRYP glCreateProgram) (void);
+	GLuint (APIENTRYP glCreateShader) (GLenum type);
+	void (APIENTRYP glDeleteProgram) (GLuint program);
+	void (APIENTRYP glDeleteShader) (GLuint shader);
+	void (APIENTRYP glDetachShader) (GLuint program, GLuint shader);
+	void (APIENTRYP glDisableVertexAttribArray) (GLuint index);
+	void (APIENTRYP glEnableVertexAttribArray) (GLuint index);
+	void (APIENTRYP glGetActiveAttrib) (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+	void (APIENTRYP glGetActiveUniform) (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+	void (APIENTRYP glGetAttachedShaders) (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders);
+	GLint (APIENTRYP glGetAttribLocation) (GLuint program, const GLchar *name);
+	void (APIENTRYP glGetProgramiv) (GLuint program, GLenum pname, GLint *params);
+	void (APIENTRYP glGetProgramInfoLog) (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog);
+	void (APIENTRYP glGetShaderiv) (GLuint shader, GLenum pname, GLint *params);
+	void (APIENTRYP glGetShaderInfoLog) (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog);
+	void (APIENTRYP glGetShaderSource) (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source);
+	GLint (APIENTRYP glGetUniformLocation) (GLuint program, const GLchar *name);
+	void (APIENTRYP glGetUniformfv) (GLuint program, GLint location, GLfloat *params);
+	void (APIENTRYP glGetUniformiv) (GLuint program, GLint location, GLint *params);
+	void (APIENTRYP glGetVertexAttribdv) (GLuint index, GLenum pname, GLdouble *params);
+	void (APIENTRYP glGetVertexAttribfv) (GLuint index, GLenum pname, GLfloat *params);
+	void (APIENTRYP glGetVertexAttribiv) (GLuint index, GLenum pname, GLint *params);
+	void (APIENTRYP glGetVertexAttribPointerv) (GLuint index, GLenum pname, void **pointer);
+	GLboolean (APIENTRYP glIsProgram) (GLuint program);
+	GLboolean (APIENTRYP glIsShader) (GLuint shader);
+	void (APIENTRYP glLinkProgram) (GLuint program);
+	void (APIENTRYP glShaderSource) (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length);
+	void (APIENTRYP glUniform1f) (GLint location, GLfloat v0);
+	void (APIENTRYP glUniform2f) (GLint location, GLfloat v0, GLfloat v1);
+	void (APIENTRYP glUniform3f) (GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+	void (APIENTRYP glUniform4f) (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+	void (APIENTRYP glUniform1i) (GLint location, GLint v0);
+	void (APIENTRYP glUniform2i) (GLint location, GLint v0, GLint v1);
+	void (APIENTRYP glUniform3i) (GLint location, GLint v0, GLint v1, GLint v2);
+	void (APIENTRYP glUniform4i) (GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
+	void (APIENTRYP glUniform1fv) (GLint location, GLsizei count, const GLfloat *value);
+	void (APIENTRYP glUniform2fv) (GLint location, GLsizei count, const GLfloat *value);
+	void (APIENTRYP glUniform3fv) (GLint location, GLsizei count, const GLfloat *value);
+	void (APIENTRYP glUniform4fv) (GLint location, GLsizei count, const GLfloat *value);
+	void (APIENTRYP glUniform1iv) (GLint location, GLsizei count, const GLint *value);
+	void (APIENTRYP glUniform2iv) (GLint location, GLsizei count, const GLint *value);
+	void (APIENTRYP glUniform3iv) (GLint location, GLsizei count, const GLint *value);
+	void (APIENTRYP glUniform4iv) (GLint location, GLsizei count, const GLint *value);
+	void (APIENTRYP glUniformMatrix2fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glUniformMatrix3fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glValidateProgram) (GLuint program);
+	void (APIENTRYP glVertexAttrib1d) (GLuint index, GLdouble x);
+	void (APIENTRYP glVertexAttrib1dv) (GLuint index, const GLdouble *v);
+	void (APIENTRYP glVertexAttrib1f) (GLuint index, GLfloat x);
+	void (APIENTRYP glVertexAttrib1fv) (GLuint index, const GLfloat *v);
+	void (APIENTRYP glVertexAttrib1s) (GLuint index, GLshort x);
+	void (APIENTRYP glVertexAttrib1sv) (GLuint index, const GLshort *v);
+	void (APIENTRYP glVertexAttrib2d) (GLuint index, GLdouble x, GLdouble y);
+	void (APIENTRYP glVertexAttrib2dv) (GLuint index, const GLdouble *v);
+	void (APIENTRYP glVertexAttrib2f) (GLuint index, GLfloat x, GLfloat y);
+	void (APIENTRYP glVertexAttrib2fv) (GLuint index, const GLfloat *v);
+	void (APIENTRYP glVertexAttrib2s) (GLuint index, GLshort x, GLshort y);
+	void (APIENTRYP glVertexAttrib2sv) (GLuint index, const GLshort *v);
+	void (APIENTRYP glVertexAttrib3d) (GLuint index, GLdouble x, GLdouble y, GLdouble z);
+	void (APIENTRYP glVertexAttrib3dv) (GLuint index, const GLdouble *v);
+	void (APIENTRYP glVertexAttrib3f) (GLuint index, GLfloat x, GLfloat y, GLfloat z);
+	void (APIENTRYP glVertexAttrib3fv) (GLuint index, const GLfloat *v);
+	void (APIENTRYP glVertexAttrib3s) (GLuint index, GLshort x, GLshort y, GLshort z);
+	void (APIENTRYP glVertexAttrib3sv) (GLuint index, const GLshort *v);
+	void (APIENTRYP glVertexAttrib4Nbv) (GLuint index, const GLbyte *v);
+	void (APIENTRYP glVertexAttrib4Niv) (GLuint index, const GLint *v);
+	void (APIENTRYP glVertexAttrib4Nsv) (GLuint index, const GLshort *v);
+	void (APIENTRYP glVertexAttrib4Nub) (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w);
+	void (APIENTRYP glVertexAttrib4Nubv) (GLuint index, const GLubyte *v);
+	void (APIENTRYP glVertexAttrib4Nuiv) (GLuint index, const GLuint *v);
+	void (APIENTRYP glVertexAttrib4Nusv) (GLuint index, const GLushort *v);
+	void (APIENTRYP glVertexAttrib4bv) (GLuint index, const GLbyte *v);
+	void (APIENTRYP glVertexAttrib4d) (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w);
+	void (APIENTRYP glVertexAttrib4dv) (GLuint index, const GLdouble *v);
+	void (APIENTRYP glVertexAttrib4f) (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+	void (APIENTRYP glVertexAttrib4fv) (GLuint index, const GLfloat *v);
+	void (APIENTRYP glVertexAttrib4iv) (GLuint index, const GLint *v);
+	void (APIENTRYP glVertexAttrib4s) (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w);
+	void (APIENTRYP glVertexAttrib4sv) (GLuint index, const GLshort *v);
+	void (APIENTRYP glVertexAttrib4ubv) (GLuint index, const GLubyte *v);
+	void (APIENTRYP glVertexAttrib4uiv) (GLuint index, const GLuint *v);
+	void (APIENTRYP glVertexAttrib4usv) (GLuint index, const GLushort *v);
+	void (APIENTRYP glVertexAttribPointer) (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
+	void (APIENTRYP glUniformMatrix2x3fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glUniformMatrix3x2fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glUniformMatrix2x4fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glUniformMatrix4x2fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glUniformMatrix3x4fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glUniformMatrix4x3fv) (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+	void (APIENTRYP glColorMaski) (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a);
+	void (APIENTRYP glGetBooleani_v) (GLenum target, GLuint index, GLboolean *data);
+	void (APIENTRYP glGetIntegeri_v) (GLenum target, GLuint index, GLint *data);
+	void (APIENTRYP glEnablei) (GLenum target, GLuint index);
+	void (APIENTRYP glDisablei) (GLenum target, GLuint index);
+	GLboolean (APIENTRYP glIsEnabledi) (GLenum target, GLuint index);
+	void (APIENTRYP glBeginTransformFeedback) (GLenum primitiveMode);
+	void (APIENTRYP glEndTransformFeedback) (void);
+	void (APIENTRYP glBindBufferRange) (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+	void (APIENTRYP glBindBufferBase) (GLenum target, GLuint index, GLuint buffer);
+	void (APIENTRYP glTransformFeedbackVaryings) (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode);
+	void (APIENTRYP glGetTransformFeedbackVarying) (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name);
+	void (APIENTRYP glClampColor) (GLenum target, GLenum clamp);
+	void (APIENTRYP glBeginConditionalRender) (GLuint id, GLenum mode);
+	void (APIENTRYP glEndConditionalRender) (void);
+	void (APIENTRYP glVertexAttribIPointer) (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer);
+	void (APIENTRYP glGetVertexAttribIiv) (GLuint index, GLenum pname, GLint *params);
+	void (APIENTRYP glGetVertexAttribIuiv) (GLuint index, GLenum pname, GLuint *params);
+	void (APIENTRYP glVertexAttribI1i) (GLuint index, GLint x);
+	void (APIENTRYP glVertexAttribI2i) (GLuint index, GLint x, GLint y);
+	void (APIENTRYP glVertexAttribI3i) (GLuint index, GLint x, GLint y, GLint z);
+	void (APIENTRYP glVertexAttribI4i) (GLuint index, GLint x, GLint y, GLint z, GLint w);
+	void (APIENTRYP glVertexAttribI1ui) (GLuint index, GLuint x);
+	void (APIENTRYP glVertexAttribI2ui) (GLuint index, GLuint x, GLuint y);
+	void (APIENTRYP glVertexAttribI3ui) (GLuint index, GLuint x, GLuint y, GLuint z);
+	void (APIENTRYP glVertexAttribI4ui) (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w);
+	void (APIENTRYP glVertexAttribI1iv) (GLuint index, const GLint *v);
+	void (APIENTRYP glVertexAttribI2iv) (GLuint index, const GLint *v);
+	void (APIENTRYP glVertexAttribI3iv) (GLuint index, const GLint *v);
+	void (APIENTRYP glVertexAttribI4iv) (GLuint index, const GLint *v);
+	void (APIENTRYP glVertexAttribI1uiv) (GLuint index, const GLuint *v);
+	void (APIENTRYP glVertexAttribI2uiv) (GLuint index, const GLuint *v);
+	void (APIENTRYP glVertexAttribI3uiv) (GLuint index, const GLuint *v);
+	void (APIENTRYP glVertexAttribI4uiv) (GLuint index, const GLuint *v);
+	void (APIENTRYP glVertexAttribI4bv) (GLuint index, const GLbyte *v);
+	void (APIENTRYP glVertexAttribI4sv) (GLuint index, const GLshort *v);
+	void (APIENTRYP glVertexAttribI4ubv) (GLuint index, const GLubyte *v);
+	void (APIENTRYP glVertexAttribI4usv) (GLuint index, const GLushort *v);
+	void (APIENTRYP glGetUniformuiv) (GLuint program, GLint location, GLuint *params);
+	void (APIENTRYP glBindFragDataLocation) (GLuint program, GLuint color, const GLchar *name);
+	GLint (APIENTRYP glGetFragDataLocation) (GLuint program, const GLchar *name);
+	void (APIENTRYP glUniform1ui) (GLint location, GLuint v0);
+	void (APIENTRYP glUniform2ui) (GLint location, GLuint v0, GLuint v1);
+	void (APIENTRYP glUniform3ui) (GLint location, GLuint v0, GLuint v1, GLuint v2);
+	void (APIENTRYP glUniform4ui) (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3);
+	void (APIENTRYP glUniform1uiv) (GLint location, GLsizei count, const GLuint *value);
+	void (APIENTRYP glUniform2uiv) (GLint location, GLsizei count, const GLuint *value);
+	void (APIENTRYP glUniform3uiv) (GLint location, GLsizei count, const GLuint *value);
+	void (APIENTRYP glUniform4uiv) (GLint location, GLsizei count, const GLuint *value);
+	void (APIENTRYP glTexParameterIiv) (GLenum target, GLenum pname, const GLint *params);
+	void (APIENTRYP glTexParameterIuiv) (GLenum target, GLenum pname, const GLuint *params);
+	void (APIENTRYP glGetTexParameterIiv) (GLenum target, GLenum pname, GLint *params);
+	void (APIENTRYP glGetTexParameterIuiv) (GLenum target, GLenum pname, GLuint *params);
+	void (APIENTRYP glClearBufferiv) (GLenum buffer, GLint drawbuffer, const GLint *value);
+	void (APIENTRYP glClearBufferuiv) (GLenum buffer, GLint drawbuffer, const GLuint *value);
+	void (APIENTRYP glClearBufferfv) (GLenum buffer, GLint drawbuffer, const GLfloat *value);
+	void (APIENTRYP glClearBufferfi) (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil);
+	const GLubyte * (APIENTRYP glGetStringi) (GLenum name, GLuint index);
+	GLboolean (APIENTRYP glIsRenderbuffer) (GLuint renderbuffer);
+	void (APIENTRYP glBindRenderbuffer) (GLenum target, GLuint renderbuffer);
+	void (APIENTRYP glDeleteRenderbuffers) (GLsizei n, const GLuint *renderbuffers);
+	void (APIENTRYP glGenRenderbuffers) (GLsizei n, GLuint *renderbuffers);
+	void (APIENTRYP glRenderbufferStorage) (GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+	void (APIENTRYP glGetRenderbufferParameteriv) (GLenum target, GLenum pname, GLint *params);
+	GLboolean (APIENTRYP glIsFramebuffer) (GLuint framebuffer);
+	void (APIENTRYP glDeleteFramebuffers) (GLsizei n, const GLuint *framebuffers);
+	void (APIENTRYP glGenFramebuffers) (GLsizei n, GLuint *framebuffers);
+	GLenum (APIENTRYP glCheckFramebufferStatus) (GLenum target);
+	void (APIENTRYP glFramebufferTexture1D) (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+	void (APIENTRYP glFramebufferTexture2D) (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+	void (APIENTRYP glFramebufferTexture3D) (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset);
+	void (APIENTRYP glFramebufferRenderbuffer) (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+	void (APIENTRYP glGetFramebufferAttachmentParameteriv) (GLenum target, GLenum attachment, GLenum pname, GLint *params);
+	void (APIENTRYP glGenerateMipmap) (GLenum target);
+	void (APIENTRYP glBlitFramebuffer) (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+	void (APIENTRYP glRenderbufferStorageMultisample) (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height);
+	void (APIENTRYP glFramebufferTextureLayer) (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer);
+	void * (APIENTRYP glMapBufferRange) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+	void (APIENTRYP glFlushMappedBufferRange) (GLenum target, GLintptr offset, GLsizeiptr length);
+	void (APIENTRYP glDeleteVertexArrays) (GLsizei n, const GLuint *arrays);
+	void (APIENTRYP glGenVertexArrays) (GLsizei n, GLuint *arrays);
+	GLboolean (APIENTRYP glIsVertexArray) (GLuint array);
+	void (APIENTRYP glDrawArraysInstanced) (GLenum mode, GLint first, GLsizei count, GLsizei instancecount);
+	void (APIENTRYP glDrawElementsInstanced) (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount);
+	void (APIENTRYP glTexBuffer) (GLenum target, GLenum internalformat, GLuint buffer);
+	void (APIENTRYP glPrimitiveRestartIndex) (GLuint index);
+	void (APIENTRYP glCopyBufferSubData) (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
+	void (APIENTRYP glGetUniformIndices) (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices);
+	void (APIENTRYP glGetActiveUniformsiv) (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params);
+	void (APIENTRYP glGetActiveUniformName) (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName);
+	GLuint (APIENTRYP glGetUniformBlockIndex) (GLuint program, const GLchar *uniformBlockName);
+	void (APIENTRYP glGetActiveUniformBlockiv) (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params);
+	void (APIENTRYP glGetActiveUniformBlockName) (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName);
+	void (APIENTRYP glUniformBlockBinding) (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+	void (APIENTRYP glDrawRangeElementsBaseVertex) (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+	void (APIENTRYP glDrawElementsInstancedBaseVertex) (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex);
+	void (APIENTRYP glMultiDrawElementsBaseVertex) (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex);
+	void (APIENTRYP glProvokingVertex) (GLenum mode);
+	GLsync (APIENTRYP glFenceSync) (GLenum condition, GLbitfield flags);
+	GLboolean (APIENTRYP glIsSync) (GLsync sync);
+	void (APIENTRYP glDeleteSync) (GLsync sync);
+	GLenum (APIENTRYP glClientWaitSync) (GLsync sync, GLbitfield flags, GLuint64 timeout);
+	void (APIENTRYP glWaitSync) (GLsync sync, GLbitfield flags, GLuint64 timeout);
+	void (APIENTRYP glGetInteger64v) (GLenum pname, GLint64 *data);
+	void (APIENTRYP glGetSynciv) (GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values);
+	void (APIENTRYP glGetInteger64i_v) (GLenum target, GLuint index, GLint64 *data);
+	void (APIENTRYP glGetBufferParameteri64v) (GLenum target, GLenum pname, GLint64 *params);
+	void (APIENTRYP glFramebufferTexture) (GLenum target, GLenum attachment, GLuint texture, GLint level);
+	void (APIENTRYP glTexImage2DMultisample) (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations);
+	void (APIENTRYP glTexImage3DMultisample) (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations);
+	void (APIENTRYP glGetMultisamplefv) (GLenum pname, GLuint index, GLfloat *val);
+	void (APIENTRYP glSampleMaski) (GLuint maskNumber, GLbitfield mask);
+	void (APIENTRYP glBindFragDataLocationIndexed) (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name);
+	GLint (APIENTRYP glGetFragDataIndex) (GLuint program, const GLchar *name);
+	void (APIENTRYP glGenSamplers) (GLsizei count, GLuint *samplers);
+	void (APIENTRYP glDeleteSamplers) (GLsizei count, const GLuint *samplers);
+	GLboolean (APIENTRYP glIsSampler) (GLuint sampler);
+	void (APIENTRYP glBindSampler) (GLuint unit, GLuint sampler);
+	void (APIENTRYP glSamplerParameteri) (GLuint sampler, GLenum pname, GLint param);
+	void (APIENTRYP glSamplerParameteriv) (GLuint sampler, GLenum pname, const GLint *param);
+	void (APIENTRYP glSamplerParameterf) (GLuint sampler, GLenum pname, GLfloat param);
+	void (APIENTRYP glSamplerParameterfv) (GLuint sampler, GLenum pname, const GLfloat *param);
+	void (APIENTRYP glSamplerParameterIiv) (GLuint sampler, GLenum pname, const GLint *param);
+	void (APIENTRYP glSamplerParameterIuiv) (GLuint sampler, GLenum pname, const GLuint *param);
+	void (APIENTRYP glGetSamplerParameteriv) (GLuint sampler, GLenum pname, GLint *params);
+	void (APIENTRYP glGetSamplerParameterIiv) (GLuint sampler, GLenum pname, GLint *params);
+	void (APIENTRYP glGetSamplerParameterfv) (GLuint sampler, GLenum pname, GLfloat *params);
+	void (APIENTRYP glGetSamplerParameterIuiv) (GLuint sampler, GLenum pname, GLuint *params);
+	void (APIENTRYP glQueryCounter) (GLuint id, GLenum target);
+	void (APIENTRYP glGetQueryObjecti64v) (GLuint id, GLenum pname, GLint64 *params);
+	void (APIENTRYP glVertexAttribDivisor) (GLuint index, GLuint divisor);
+	void (APIENTRYP glVertexAttribP1ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
+	void (APIENTRYP glVertexAttribP1uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
+	void (APIENTRYP glVertexAttribP2ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
+	void (APIENTRYP glVertexAttribP2uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
+	void (APIENTRYP glVertexAttribP3ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
+	void (APIENTRYP glVertexAttribP3uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
+	void (APIENTRYP glVertexAttribP4ui) (GLuint index, GLenum type, GLboolean normalized, GLuint value);
+	void (APIENTRYP glVertexAttribP4uiv) (GLuint index, GLenum type, GLboolean normalized, const GLuint *value);
+
+	//extensions (null if not available):
+	void (APIENTRYP glBufferStorage) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+	void (APIENTRYP glDebugMessageControl) (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled);
+	void (APIENTRYP glDebugMessageInsert) (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf);
+	void (APIENTRYP glDebugMessageCallback) (GLDEBUGPROC callback, const void *userParam);
+	GLuint (APIENTRYP glGetDebugMessageLog) (GLuint count, GLsizei bufSize, GLenum *sources, GLenum *types, GLuint *ids, GLenum *severities, GLsizei *lengths, GLchar *messageLog);
+	void (APIENTRYP glPushDebugGroup) (GLenum source, GLuint id, GLsizei length, const GLchar *message);
+	void (APIENTRYP glPopDebugGroup) (void);
+	void (APIENTRYP glObjectLabel) (GLenum identifier, GLuint name, GLsizei length, const GLchar *label);
+	void (APIENTRYP glGetObjectLabel) (GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label);
+	void (APIENTRYP glObjectPtrLabel) (const void *ptr, GLsizei length, const GLchar *label);
+	void (APIENTRYP glGetObjectPtrLabel) (const void *ptr, GLsizei bufSize, GLsizei *length, GLchar *label);
+	void (APIENTRYP glMaxShaderCompilerThreadsKHR) (GLuint count);
+	void (APIENTRYP glGetProgramBinary) (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+	void (APIENTRYP glProgramBinary) (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+	void (APIENTRYP glProgramParameteri) (GLuint program, GLenum pname, GLint value);
+	void (APIENTRYP glDrawArraysIndirect) (GLenum mode, const void *indirect);
+	void (APIENTRYP glDrawElementsIndirect) (GLenum mode, GLenum type, const void *indirect);
+	void (APIENTRYP glMultiDrawArraysIndirect) (GLenum mode, const void *indirect, GLsizei drawcount, GLsizei stride);
+	void (APIENTRYP glMultiDrawElementsIndirect) (GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride);
+};
+extern GLDispatch gl_dispatch;
+
+//which extensions init_GL() found (and loaded every function of):
+struct GLExtensions {
+	bool ARB_buffer_storage = false;
+	bool KHR_debug = false;
+	bool KHR_parallel_shader_compile = false;
+	bool ARB_get_program_binary = false;
+	bool ARB_draw_indirect = false;
+	bool ARB_multi_draw_indirect = false;
+};
+extern GLExtensions gl_extensions;
+
+#ifdef GL_DISPATCH_TABLE
+#define glDrawElementsBaseVertex gl_dispatch.glDrawElementsBaseVertex
+#define glDrawElements gl_dispatch.glDrawElements
+#define glDrawArrays gl_dispatch.glDrawArrays
+#define glUseProgram gl_dispatch.glUseProgram
+#define glBindVertexArray gl_dispatch.glBindVertexArray
+#define glBindBuffer gl_dispatch.glBindBuffer
+#define glBindTexture gl_dispatch.glBindTexture
+#define glActiveTexture gl_dispatch.glActiveTexture
+#define glBufferData gl_dispatch.glBufferData
+#define glBufferSubData gl_dispatch.glBufferSubData
+#define glUniformMatrix4fv gl_dispatch.glUniformMatrix4fv
+#define glEnable gl_dispatch.glEnable
+#define glDisable gl_dispatch.glDisable
+#define glBlendFunc gl_dispatch.glBlendFunc
+#define glClearColor gl_dispatch.glClearColor
+#define glClear gl_dispatch.glClear
+#define glViewport gl_dispatch.glViewport
+#define glBeginQuery gl_dispatch.glBeginQuery
+#define glEndQuery gl_dispatch.glEndQuery
+#define glGetQueryObjectuiv gl_dispatch.glGetQueryObjectuiv
+#define glGetQueryObjectui64v gl_dispatch.glGetQueryObjectui64v
+#define glGetError gl_dispatch.glGetError
+#define glBindFramebuffer gl_dispatch.glBindFramebuffer
+#define glCullFace gl_dispatch.glCullFace
+#define glFrontFace gl_dispatch.glFrontFace
+#define glHint gl_dispatch.glHint
+#define glLineWidth gl_dispatch.glLineWidth
+#define glPointSize gl_dispatch.glPointSize
+#define glPolygonMode gl_dispatch.glPolygonMode
+#define glScissor gl_dispatch.glScissor
+#define glTexParameterf gl_dispatch.glTexParameterf
+#define glTexParameterfv gl_dispatch.glTexParameterfv
+#define glTexParameteri gl_dispatch.glTexParameteri
+#define glTexParameteriv gl_dispatch.glTexParameteriv
+#define glTexImage1D gl_dispatch.glTexImage1D
+#define glTexImage2D gl_dispatch.glTexImage2D
+#define glDrawBuffer gl_dispatch.glDrawBuffer
+#define glClearStencil gl_dispatch.glClearStencil
+#define glClearDepth gl_dispatch.glClearDepth
+#define glStencilMask gl_dispatch.glStencilMask
+#define glColorMask gl_dispatch.glColorMask
+#define glDepthMask gl_dispatch.glDepthMask
+#define glFinish gl_dispatch.glFinish
+#define glFlush gl_dispatch.glFlush
+#define glLogicOp gl_dispatch.glLogicOp
+#define glStencilFunc gl_dispatch.glStencilFunc
+#define glStencilOp gl_dispatch.glStencilOp
+#define glDepthFunc gl_dispatch.glDepthFunc
+#define glPixelStoref gl_dispatch.glPixelStoref
+#define glPixelStorei gl_dispatch.glPixelStorei
+#define glReadBuffer gl_dispatch.glReadBuffer
+#define glReadPixels gl_dispatch.glReadPixels
+#define glGetBooleanv gl_dispatch.glGetBooleanv
+#define glGetDoublev gl_dispatch.glGetDoublev
+#define glGetFloatv gl_dispatch.glGetFloatv
+#define glGetIntegerv gl_dispatch.glGetIntegerv
+#define glGetString gl_dispatch.glGetString
+#define glGetTexImage gl_dispatch.glGetTexImage
+#define glGetTexParameterfv gl_dispatch.glGetTexParameterfv
+#define glGetTexParameteriv gl_dispatch.glGetTexParameteriv
+#define glGetTexLevelParameterfv gl_dispatch.glGetTexLevelParameterfv
+#define glGetTexLevelParameteriv gl_dispatch.glGetTexLevelParameteriv
+#define glIsEnabled gl_dispatch.glIsEnabled
+#define glDepthRange gl_dispatch.glDepthRange
+#define glGetPointerv gl_dispatch.glGetPointerv
+#define glPolygonOffset gl_dispatch.glPolygonOffset
+#define glCopyTexImage1D gl_dispatch.glCopyTexImage1D
+#define glCopyTexImage2D gl_dispatch.glCopyTexImage2D
+#define glCopyTexSubImage1D gl_dispatch.glCopyTexSubImage1D
+#define glCopyTexSubImage2D gl_dispatch.glCopyTexSubImage2D
+#define glTexSubImage1D gl_dispatch.glTexSubImage1D
+#define glTexSubImage2D gl_dispatch.glTexSubImage2D
+#define glDeleteTextures gl_dispatch.glDeleteTextures
+#define glGenTextures gl_dispatch.glGenTextures
+#define glIsTexture gl_dispatch.glIsTexture
+#define glDrawRangeElements gl_dispatch.glDrawRangeElements
+#define glTexImage3D gl_dispatch.glTexImage3D
+#define glTexSubImage3D gl_dispatch.glTexSubImage3D
+#define glCopyTexSubImage3D gl_dispatch.glCopyTexSubImage3D
+#define glSampleCoverage gl_dispatch.glSampleCoverage
+#define glCompressedTexImage3D gl_dispatch.glCompressedTexImage3D
+#define glCompressedTexImage2D gl_dispatch.glCompressedTexImage2D
+#define glCompressedTexImage1D gl_dispatch.glCompressedTexImage1D
+#define glCompressedTexSubImage3D gl_dispatch.glCompressedTexSubImage3D
+#define glCompressedTexSubImage2D gl_dispatch.glCompressedTexSubImage2D
+#define glCompressedTexSubImage1D gl_dispatch.glCompressedTexSubImage1D
+#define glGetCompressedTexImage gl_dispatch.glGetCompressedTexImage
+#define glBlendFuncSeparate gl_dispatch.glBlendFuncSeparate
+#define glMultiDrawArrays gl_dispatch.glMultiDrawArrays
+#define glMultiDrawElements gl_dispatch.glMultiDrawElements
+#define glPointParameterf gl_dispatch.glPointParameterf
+#define glPointParameterfv gl_dispatch.glPointParameterfv
+#define glPointParameteri gl_dispatch.glPointParameteri
+#define glPointParameteriv gl_dispatch.glPointParameteriv
+#define glBlendColor gl_dispatch.glBlendColor
+#define glBlendEquation gl_dispatch.glBlendEquation
+#define glGenQueries gl_dispatch.glGenQueries
+#define glDeleteQueries gl_dispatch.glDeleteQueries
+#define glIsQuery gl_dispatch.glIsQuery
+#define glGetQueryiv gl_dispatch.glGetQueryiv
+#define glGetQueryObjectiv gl_dispatch.glGetQueryObjectiv
+#define glDeleteBuffers gl_dispatch.glDeleteBuffers
+#define glGenBuffers gl_dispatch.glGenBuffers
+#define glIsBuffer gl_dispatch.glIsBuffer
+#define glGetBufferSubData gl_dispatch.glGetBufferSubData
+#define glMapBuffer gl_dispatch.glMapBuffer
+#define glUnmapBuffer gl_dispatch.glUnmapBuffer
+#define glGetBufferParameteriv gl_dispatch.glGetBufferParameteriv
+#define glGetBufferPointerv gl_dispatch.glGetBufferPointerv
+#define glBlendEquationSeparate gl_dispatch.glBlendEquationSeparate
+#define glDrawBuffers gl_dispatch.glDrawBuffers
+#define glStencilOpSeparate gl_dispatch.glStencilOpSeparate
+#define glStencilFuncSeparate gl_dispatch.glStencilFuncSeparate
+#define glStencilMaskSeparate gl_dispatch.glStencilMaskSeparate
+#define glAttachShader gl_dispatch.glAttachShader
+#define glBindAttribLocation gl_dispatch.glBindAttribLocation
+#define glCompileShader gl_dispatch.glCompileShader
+#define glCreateProgram gl_dispatch.glCreateProgram
+#define glCreateShader gl_dispatch.glCreateShader
+#define glDeleteProgram gl_dispatch.glDeleteProgram
+#define glDeleteShader gl_dispatch.glDeleteShader
+#define glDetachShader gl_dispatch.glDetachShader
+#define glDisableVertexAttribArray gl_dispatch.glDisableVertexAttribArray
+#define glEnableVertexAttribArray gl_dispatch.glEnableVertexAttribArray
+#define glGetActiveAttrib gl_dispatch.glGetActiveAttrib
+#define glGetActiveUniform gl_dispatch.glGetActiveUniform
+#define glGetAttachedShaders gl_dispatch.glGetAttachedShaders
+#define glGetAttribLocation gl_dispatch.glGetAttribLocation
+#define glGetProgramiv gl_dispatch.glGetProgramiv
+#define glGetProgramInfoLog gl_dispatch.glGetProgramInfoLog
+#define glGetShaderiv gl_dispatch.glGetShaderiv
+#define glGetShaderInfoLog gl_dispatch.glGetShaderInfoLog
+#define glGetShaderSource gl_dispatch.glGetShaderSource
+#define glGetUniformLocation gl_dispatch.glGetUniformLocation
+#define glGetUniformfv gl_dispatch.glGetUniformfv
+#define glGetUniformiv gl_dispatch.glGetUniformiv
+#define glGetVertexAttribdv gl_dispatch.glGetVertexAttribdv
+#define glGetVertexAttribfv gl_dispatch.glGetVertexAttribfv
+#define glGetVertexAttribiv gl_dispatch.glGetVertexAttribiv
+#define glGetVertexAttribPointerv gl_dispatch.glGetVertexAttribPointerv
+#define glIsProgram gl_dispatch.glIsProgram
+#define glIsShader gl_dispatch.glIsShader
+#define glLinkProgram gl_dispatch.glLinkProgram
+#define glShaderSource gl_dispatch.glShaderSource
+#define glUniform1f gl_dispatch.glUniform1f
+#define glUniform2f gl_dispatch.glUniform2f
+#define glUniform3f gl_dispatch.glUniform3f
+#define glUniform4f gl_dispatch.glUniform4f
+#define glUniform1i gl_dispatch.glUniform1i
+#define glUniform2i gl_dispatch.glUniform2i
+#define glUniform3i gl_dispatch.glUniform3i
+#define glUniform4i gl_dispatch.glUniform4i
+#define glUniform1fv gl_dispatch.glUniform1fv
+#define glUniform2fv gl_dispatch.glUniform2fv
+#define glUniform3fv gl_dispatch.glUniform3fv
+#define glUniform4fv gl_dispatch.glUniform4fv
+#define glUniform1iv gl_dispatch.glUniform1iv
+#define glUniform2iv gl_dispatch.glUniform2iv
+#define glUniform3iv gl_dispatch.glUniform3iv
+#define glUniform4iv gl_dispatch.glUniform4iv
+#define glUniformMatrix2fv gl_dispatch.glUniformMatrix2fv
+#define glUniformMatrix3fv gl_dispatch.glUniformMatrix3fv
+#define glValidateProgram gl_dispatch.glValidateProgram
+#define glVertexAttrib1d gl_dispatch.glVertexAttrib1d
+#define glVertexAttrib1dv gl_dispatch.glVertexAttrib1dv
+#define glVertexAttrib1f gl_dispatch.glVertexAttrib1f
+#define glVertexAttrib1fv gl_dispatch.glVertexAttrib1fv
+#define glVertexAttrib1s gl_dispatch.glVertexAttrib1s
+#define glVertexAttrib1sv gl_dispatch.glVertexAttrib1sv
+#define glVertexAttrib2d gl_dispatch.glVertexAttrib2d
+#define glVertexAttrib2dv gl_dispatch.glVertexAttrib2dv
+#define glVertexAttrib2f gl_dispatch.glVertexAttrib2f
+#define glVertexAttrib2fv gl_dispatch.glVertexAttrib2fv
+#define glVertexAttrib2s gl_dispatch.glVertexAttrib2s
+#define glVertexAttrib2sv gl_dispatch.glVertexAttrib2sv
+#define glVertexAttrib3d gl_dispatch.glVertexAttrib3d
+#define glVertexAttrib3dv gl_dispatch.glVertexAttrib3dv
+#define glVertexAttrib3f gl_dispatch.glVertexAttrib3f
+#define glVertexAttrib3fv gl_dispatch.glVertexAttrib3fv
+#define glVertexAttrib3s gl_dispatch.glVertexAttrib3s
+#define glVertexAttrib3sv gl_dispatch.glVertexAttrib3sv
+#define glVertexAttrib4Nbv gl_dispatch.glVertexAttrib4Nbv
+#define glVertexAttrib4Niv gl_dispatch.glVertexAttrib4Niv
+#define glVertexAttrib4Nsv gl_dispatch.glVertexAttrib4Nsv
+#define glVertexAttrib4Nub gl_dispatch.glVertexAttrib4Nub
+#define glVertexAttrib4Nubv gl_dispatch.glVertexAttrib4Nubv
+#define glVertexAttrib4Nuiv gl_dispatch.glVertexAttrib4Nuiv
+#define glVertexAttrib4Nusv gl_dispatch.glVertexAttrib4Nusv
+#define glVertexAttrib4bv gl_dispatch.glVertexAttrib4bv
+#define glVertexAttrib4d gl_dispatch.glVertexAttrib4d
+#define glVertexAttrib4dv gl_dispatch.glVertexAttrib4dv
+#define glVertexAttrib4f gl_dispatch.glVertexAttrib4f
+#define glVertexAttrib4fv gl_dispatch.glVertexAttrib4fv
+#define glVertexAttrib4iv gl_dispatch.glVertexAttrib4iv
+#define glVertexAttrib4s gl_dispatch.glVertexAttrib4s
+#define glVertexAttrib4sv gl_dispatch.glVertexAttrib4sv
+#define glVertexAttrib4ubv gl_dispatch.glVertexAttrib4ubv
+#define glVertexAttrib4uiv gl_dispatch.glVertexAttrib4uiv
+#define glVertexAttrib4usv gl_dispatch.glVertexAttrib4usv
+#define glVertexAttribPointer gl_dispatch.glVertexAttribPointer
+#define glUniformMatrix2x3fv gl_dispatch.glUniformMatrix2x3fv
+#define glUniformMatrix3x2fv gl_dispatch.glUniformMatrix3x2fv
+#define glUniformMatrix2x4fv gl_dispatch.glUniformMatrix2x4fv
+#define glUniformMatrix4x2fv gl_dispatch.glUniformMatrix4x2fv
+#define glUniformMatrix3x4fv gl_dispatch.glUniformMatrix3x4fv
+#define glUniformMatrix4x3fv gl_dispatch.glUniformMatrix4x3fv
+#define glColorMaski gl_dispatch.glColorMaski
+#define glGetBooleani_v gl_dispatch.glGetBooleani_v
+#define glGetIntegeri_v gl_dispatch.glGetIntegeri_v
+#define glEnablei gl_dispatch.glEnablei
+#define glDisablei gl_dispatch.glDisablei
+#define glIsEnabledi gl_dispatch.glIsEnabledi
+#define glBeginTransformFeedback gl_dispatch.glBeginTransformFeedback
+#define glEndTransformFeedback gl_dispatch.glEndTransformFeedback
+#define glBindBufferRange gl_dispatch.glBindBufferRange
+#define glBindBufferBase gl_dispatch.glBindBufferBase
+#define glTransformFeedbackVaryings gl_dispatch.glTransformFeedbackVaryings
+#define glGetTransformFeedbackVarying gl_dispatch.glGetTransformFeedbackVarying
+#define glClampColor gl_dispatch.glClampColor
+#define glBeginConditionalRender gl_dispatch.glBeginConditionalRender
+#define glEndConditionalRender gl_dispatch.glEndConditionalRender
+#define glVertexAttribIPointer gl_dispatch.glVertexAttribIPointer
+#define glGetVertexAttribIiv gl_dispatch.glGetVertexAttribIiv
+#define glGetVertexAttribIuiv gl_dispatch.glGetVertexAttribIuiv
+#define glVertexAttribI1i gl_dispatch.glVertexAttribI1i
+#define glVertexAttribI2i gl_dispatch.glVertexAttribI2i
+#define glVertexAttribI3i gl_dispatch.glVertexAttribI3i
+#define glVertexAttribI4i gl_dispatch.glVertexAttribI4i
+#define glVertexAttribI1ui gl_dispatch.glVertexAttribI1ui
+#define glVertexAttribI2ui gl_dispatch.glVertexAttribI2ui
+#define glVertexAttribI3ui gl_dispatch.glVertexAttribI3ui
+#define glVertexAttribI4ui gl_dispatch.glVertexAttribI4ui
+#define glVertexAttribI1iv gl_dispatch.glVertexAttribI1iv
+#define glVertexAttribI2iv gl_dispatch.glVertexAttribI2iv
+#define glVertexAttribI3iv gl_dispatch.glVertexAttribI3iv
+#define glVertexAttribI4iv gl_dispatch.glVertexAttribI4iv
+#define glVertexAttribI1uiv gl_dispatch.glVertexAttribI1uiv
+#define glVertexAttribI2uiv gl_dispatch.glVertexAttribI2uiv
+#define glVertexAttribI3uiv gl_dispatch.glVertexAttribI3uiv
+#define glVertexAttribI4uiv gl_dispatch.glVertexAttribI4uiv
+#define glVertexAttribI4bv gl_dispatch.glVertexAttribI4bv
+#define glVertexAttribI4sv gl_dispatch.glVertexAttribI4sv
+#define glVertexAttribI4ubv gl_dispatch.glVertexAttribI4ubv
+#define glVertexAttribI4usv gl_dispatch.glVertexAttribI4usv
+#define glGetUniformuiv gl_dispatch.glGetUniformuiv
+#define glBindFragDataLocation gl_dispatch.glBindFragDataLocation
+#define glGetFragDataLocation gl_dispatch.glGetFragDataLocation
+#define glUniform1ui gl_dispatch.glUniform1ui
+#define glUniform2ui gl_dispatch.glUniform2ui
+#define glUniform3ui gl_dispatch.glUniform3ui
+#define glUniform4ui gl_dispatch.glUniform4ui
+#define glUniform1uiv gl_dispatch.glUniform1uiv
+#define glUniform2uiv gl_dispatch.glUniform2uiv
+#define glUniform3uiv gl_dispatch.glUniform3uiv
+#define glUniform4uiv gl_dispatch.glUniform4uiv
+#define glTexParameterIiv gl_dispatch.glTexParameterIiv
+#define glTexParameterIuiv gl_dispatch.glTexParameterIuiv
+#define glGetTexParameterIiv gl_dispatch.glGetTexParameterIiv
+#define glGetTexParameterIuiv gl_dispatch.glGetTexParameterIuiv
+#define glClearBufferiv gl_dispatch.glClearBufferiv
+#define glClearBufferuiv gl_dispatch.glClearBufferuiv
+#define glClearBufferfv gl_dispatch.glClearBufferfv
+#define glClearBufferfi gl_dispatch.glClearBufferfi
+#define glGetStringi gl_dispatch.glGetStringi
+#define glIsRenderbuffer gl_dispatch.glIsRenderbuffer
+#define glBindRenderbuffer gl_dispatch.glBindRenderbuffer
+#define glDeleteRenderbuffers gl_dispatch.glDeleteRenderbuffers
+#define glGenRenderbuffers gl_dispatch.glGenRenderbuffers
+#define glRenderbufferStorage gl_dispatch.glRenderbufferStorage
+#define glGetRenderbufferParameteriv gl_dispatch.glGetRenderbufferParameteriv
+#define glIsFramebuffer gl_dispatch.glIsFramebuffer
+#define glDeleteFramebuffers gl_dispatch.glDeleteFramebuffers
+#define glGenFramebuffers gl_dispatch.glGenFramebuffers
+#define glCheckFramebufferStatus gl_dispatch.glCheckFramebufferStatus
+#define glFramebufferTexture1D gl_dispatch.glFramebufferTexture1D
+#define glFramebufferTexture2D gl_dispatch.glFramebufferTexture2D
+#define glFramebufferTexture3D gl_dispatch.glFramebufferTexture3D
+#define glFramebufferRenderbuffer gl_dispatch.glFramebufferRenderbuffer
+#define glGetFramebufferAttachmentParameteriv gl_dispatch.glGetFramebufferAttachmentParameteriv
+#define glGenerateMipmap gl_dispatch.glGenerateMipmap
+#define glBlitFramebuffer gl_dispatch.glBlitFramebuffer
+#define glRenderbufferStorageMultisample gl_dispatch.glRenderbufferStorageMultisample
+#define glFramebufferTextureLayer gl_dispatch.glFramebufferTextureLayer
+#define glMapBufferRange gl_dispatch.glMapBufferRange
+#define glFlushMappedBufferRange gl_dispatch.glFlushMappedBufferRange
+#define glDeleteVertexArrays gl_dispatch.glDeleteVertexArrays
+#define glGenVertexArrays gl_dispatch.glGenVertexArrays
+#define glIsVertexArray gl_dispatch.glIsVertexArray
+#define glDrawArraysInstanced gl_dispatch.glDrawArraysInstanced
+#define glDrawElementsInstanced gl_dispatch.glDrawElementsInstanced
+#define glTexBuffer gl_dispatch.glTexBuffer
+#define glPrimitiveRestartIndex gl_dispatch.glPrimitiveRestartIndex
+#define glCopyBufferSubData gl_dispatch.glCopyBufferSubData
+#define glGetUniformIndices gl_dispatch.glGetUniformIndices
+#define glGetActiveUniformsiv gl_dispatch.glGetActiveUniformsiv
+#define glGetActiveUniformName gl_dispatch.glGetActiveUniformName
+#define glGetUniformBlockIndex gl_dispatch.glGetUniformBlockIndex
+#define glGetActiveUniformBlockiv gl_dispatch.glGetActiveUniformBlockiv
+#define glGetActiveUniformBlockName gl_dispatch.glGetActiveUniformBlockName
+#define glUniformBlockBinding gl_dispatch.glUniformBlockBinding
+#define glDrawRangeElementsBaseVertex gl_dispatch.glDrawRangeElementsBaseVertex
+#define glDrawElementsInstancedBaseVertex gl_dispatch.glDrawElementsInstancedBaseVertex
+#define glMultiDrawElementsBaseVertex gl_dispatch.glMultiDrawElementsBaseVertex
+#define glProvokingVertex gl_dispatch.glProvokingVertex
+#define glFenceSync gl_dispatch.glFenceSync
+#define glIsSync gl_dispatch.glIsSync
+#define glDeleteSync gl_dispatch.glDeleteSync
+#define glClientWaitSync gl_dispatch.glClientWaitSync
+#define glWaitSync gl_dispatch.glWaitSync
+#define glGetInteger64v gl_dispatch.glGetInteger64v
+#define glGetSynciv gl_dispatch.glGetSynciv
+#define glGetInteger64i_v gl_dispatch.glGetInteger64i_v
+#define glGetBufferParameteri64v gl_dispatch.glGetBufferParameteri64v
+#define glFramebufferTexture gl_dispatch.glFramebufferTexture
+#define glTexImage2DMultisample gl_dispatch.glTexImage2DMultisample
+#define glTexImage3DMultisample gl_dispatch.glTexImage3DMultisample
+#define glGetMultisamplefv gl_dispatch.glGetMultisamplefv
+#define glSampleMaski gl_dispatch.glSampleMaski
+#define glBindFragDataLocationIndexed gl_dispatch.glBindFragDataLocationIndexed
+#define glGetFragDataIndex gl_dispatch.glGetFragDataIndex
+#define glGenSamplers gl_dispatch.glGenSamplers
+#define glDeleteSamplers gl_dispatch.glDeleteSamplers
+#define glIsSampler gl_dispatch.glIsSampler
+#define glBindSampler gl_dispatch.glBindSampler
+#define glSamplerParameteri gl_dispatch.glSamplerParameteri
+#define glSamplerParameteriv gl_dispatch.glSamplerParameteriv
+#define glSamplerParameterf gl_dispatch.glSamplerParameterf
+#define glSamplerParameterfv gl_dispatch.glSamplerParameterfv
+#define glSamplerParameterIiv gl_dispatch.glSamplerParameterIiv
+#define glSamplerParameterIuiv gl_dispatch.glSamplerParameterIuiv
+#define glGetSamplerParameteriv gl_dispatch.glGetSamplerParameteriv
+#define glGetSamplerParameterIiv gl_dispatch.glGetSamplerParameterIiv
+#define glGetSamplerParameterfv gl_dispatch.glGetSamplerParameterfv
+#define glGetSamplerParameterIuiv gl_dispatch.glGetSamplerParameterIuiv
+#define glQueryCounter gl_dispatch.glQueryCounter
+#define glGetQueryObjecti64v gl_dispatch.glGetQueryObjecti64v
+#define glVertexAttribDivisor gl_dispatch.glVertexAttribDivisor
+#define glVertexAttribP1ui gl_dispatch.glVertexAttribP1ui
+#define glVertexAttribP1uiv gl_dispatch.glVertexAttribP1uiv
+#define glVertexAttribP2ui gl_dispatch.glVertexAttribP2ui
+#define glVertexAttribP2uiv gl_dispatch.glVertexAttribP2uiv
+#define glVertexAttribP3ui gl_dispatch.glVertexAttribP3ui
+#define glVertexAttribP3uiv gl_dispatch.glVertexAttribP3uiv
+#define glVertexAttribP4ui gl_dispatch.glVertexAttribP4ui
+#define glVertexAttribP4uiv gl_dispatch.glVertexAttribP4uiv
+#endif
+#define glBufferStorage gl_dispatch.glBufferStorage
+#define glDebugMessageControl gl_dispatch.glDebugMessageControl
+#define glDebugMessageInsert gl_dispatch.glDebugMessageInsert
+#define glDebugMessageCallback gl_dispatch.glDebugMessageCallback
+#define glGetDebugMessageLog gl_dispatch.glGetDebugMessageLog
+#define glPushDebugGroup gl_dispatch.glPushDebugGroup
+#define glPopDebugGroup gl_dispatch.glPopDebugGroup
+#define glObjectLabel gl_dispatch.glObjectLabel
+#define glGetObjectLabel gl_dispatch.glGetObjectLabel
+#define glObjectPtrLabel gl_dispatch.glObjectPtrLabel
+#define glGetObjectPtrLabel gl_dispatch.glGetObjectPtrLabel
+#define glMaxShaderCompilerThreadsKHR gl_dispatch.glMaxShaderCompilerThreadsKHR
+#define glGetProgramBinary gl_dispatch.glGetProgramBinary
+#define glProgramBinary gl_dispatch.glProgramBinary
+#define glProgramParameteri gl_dispatch.glProgramParameteri
+#define glDrawArraysIndirect gl_dispatch.glDrawArraysIndirect
+#define glDrawElementsIndirect gl_dispatch.glDrawElementsIndirect
+#define glMultiDrawArraysIndirect gl_dispatch.glMultiDrawArraysIndirect
+#define glMultiDrawElementsIndirect gl_dispatch.glMultiDrawElementsIndirect
@@ -0,0 +1,69 @@
+#include "GPUTimer.hpp"
+
+#include "Profiler.hpp"
+
+#include <cassert>
+#include <cstring>
+
+GPUTimer::~GPUTimer() {
+	for (auto &pass : passes) {
+		for (auto &slot : pass.slots) {
+			glDeleteQueries(1, &slot.query);
+			slot.query = 0;
+		}
+	}
+}
+
+bool GPUTimer::collect(Pass &pass, Slot &slot) {
+	if (!slot.pending) return true;
+
+	GLuint available = GL_FALSE;
+	glGetQueryObjectuiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (available != GL_TRUE) return false;
+
+	GLuint64 elapsed_ns = 0;
+	glGetQueryObjectui64v(slot.query, GL_QUERY_RESULT, &elapsed_ns);
+	profiler.record(pass.name, elapsed_ns);
+	slot.pending = false;
+	return true;
+}
+
+void GPUTimer::new_frame() {
+	assert(active == -1 && "GPUTimer pass left open at end of frame");
+	++frame;
+	for (auto &pass : passes) {
+		for (auto &slot : pass.slots) {
+			collect(pass, slot);
+		}
+	}
+}
+
+void GPUTimer::begin(char const *name) {
+	assert(active == -1 && "GPUTimer passes can't nest");
+
+	uint32_t index = 0;
+	while (index < passes.size() && passes[index].name != name && std::strcmp(passes[index].name, name) != 0) {
+		++index;
+	}
+	if (index == passes.size()) {
+		passes.emplace_back();
+		passes.back().name = name;
+		for (auto &slot : passes.back().slots) {
+			glGenQueries(1, &slot.query);
+		}
+	}
+
+	Pass &pass = passes[index];
+	Slot &slot = pass.slots[frame % Frames];
+	if (!collect(pass, slot)) return; //result from Frames frames ago still not back; skip rather than stall
+
+	glBeginQuery(GL_TIME_ELAPSED, slot.query);
+	slot.pending = true;
+	active = int32_t(index);
+}
+
+void GPUTimer::end() {
+	if (active == -1) return; //begin() skipped this pass
+	glEndQuery(GL_TIME_ELAPSED);
+	active = -1;
+}
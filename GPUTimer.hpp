@@ -0,0 +1,52 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/*
+ * GPUTimer measures GPU time for named passes with GL_TIME_ELAPSED queries.
+ *
+ * Each pass keeps a ring of Frames query objects; results are read back only
+ *  once GL_QUERY_RESULT_AVAILABLE says they are ready (usually a frame or two
+ *  later), so timing never stalls the pipeline. If a pass's query slot is
+ *  still in flight when it comes around again, that frame goes untimed.
+ *
+ * Finished results are reported to the profiler as "gpu.<pass>" zones, so
+ *  they show up in the overlay and CSV next to the CPU timings.
+ *
+ * NOTE: GL_TIME_ELAPSED queries can't nest, so passes must not overlap.
+ */
+
+struct GPUTimer {
+	GPUTimer() = default;
+	~GPUTimer();
+	GPUTimer(GPUTimer const &) = delete;
+	GPUTimer &operator=(GPUTimer const &) = delete;
+
+	static constexpr uint32_t Frames = 4;
+
+	//call once per frame before any begin(), to collect finished results:
+	void new_frame();
+
+	//time GL commands issued between begin() and end() ('name' must be a string literal):
+	void begin(char const *name);
+	void end();
+
+	//---- internals ----
+	struct Slot {
+		GLuint query = 0;
+		bool pending = false; //query issued but result not yet read
+	};
+	struct Pass {
+		char const *name = nullptr;
+		std::array< Slot, Frames > slots;
+	};
+	std::vector< Pass > passes;
+	uint32_t frame = 0;
+	int32_t active = -1; //index of pass currently being timed, if any
+
+	bool collect(Pass &pass, Slot &slot); //returns true if slot is free
+};
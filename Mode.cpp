@@ -1,8 +1,60 @@
 #include "Mode.hpp"
 
+std::vector< std::shared_ptr< Mode > > Mode::stack;
 std::shared_ptr< Mode > Mode::current;
 
 void Mode::set_current(std::shared_ptr< Mode > const &new_current) {
-	current = new_current;
+	stack.clear();
+	current = nullptr;
+	if (new_current) push(new_current);
 	//NOTE: may wish to, e.g., trigger resize events on new current mode.
 }
+
+void Mode::push(std::shared_ptr< Mode > const &mode, bool overlay) {
+	assert(mode);
+	mode->overlay = overlay;
+	stack.emplace_back(mode);
+	current = mode;
+}
+
+void Mode::pop() {
+	assert(!stack.empty());
+	stack.pop_back();
+	current = (stack.empty() ? nullptr : stack.back());
+}
+
+//index of the lowest visible mode:
+static size_t visible_begin(std::vector< std::shared_ptr< Mode > > const &stack) {
+	size_t begin = stack.size();
+	while (begin > 0) {
+		--begin;
+		if (!stack[begin]->overlay) break;
+	}
+	return begin;
+}
+
+//(the loops below walk copies of the stack, since a mode may push or pop while handling an event or updating)
+
+bool Mode::stack_handle_event(SDL_Event const &evt, glm::uvec2 const &window_size) {
+	std::vector< std::shared_ptr< Mode > > modes = stack;
+	for (size_t i = modes.size(); i > 0; --i) {
+		Mode &mode = *modes[i-1];
+		if (mode.handle_event(evt, window_size)) return true;
+		if (!mode.overlay) break;
+	}
+	return false;
+}
+
+void Mode::stack_update(float elapsed) {
+	std::vector< std::shared_ptr< Mode > > modes = stack;
+	for (size_t i = visible_begin(modes); i < modes.size(); ++i) {
+		modes[i]->update(elapsed);
+	}
+}
+
+void Mode::stack_draw(glm::uvec2 const &drawable_size) {
+	std::vector< std::shared_ptr< Mode > > modes = stack;
+	for (size_t i = visible_begin(modes); i < modes.size(); ++i) {
+		modes[i]->draw(drawable_size);
+	}
+}
@@ -3,7 +3,11 @@
 #include <SDL.h>
 #include <glm/glm.hpp>
 
+#include <cassert>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <vector>
 
 struct Mode : std::enable_shared_from_this< Mode > {
 	virtual ~Mode() { }
@@ -20,9 +24,51 @@ struct Mode : std::enable_shared_from_this< Mode > {
 	//draw is called after update:
 	virtual void draw(glm::uvec2 const &drawable_size) = 0;
 
-	//Mode::current is the Mode to which events are dispatched.
-	// use 'set_current' to change the current Mode (e.g., to switch to a menu)
-	static std::shared_ptr< Mode > current;
+	//----- mode stack -----
+	//Modes form a stack; the top is Mode::current, to which events are dispatched first.
+	//A mode pushed as an 'overlay' (a menu, a pause screen, a debug display) draws over the modes
+	// under it and lets the events it doesn't handle fall through to them; the modes under it
+	// keep updating. A mode pushed normally hides (and pauses) everything under it.
+	static std::vector< std::shared_ptr< Mode > > stack;
+	static std::shared_ptr< Mode > current; //== stack.back(), or nullptr when the stack is empty
+
+	//use 'set_current' to replace the whole stack with one mode (e.g., to switch to a new game);
+	// nullptr empties the stack (which main.cpp takes as the signal to quit):
 	static void set_current(std::shared_ptr< Mode > const &);
-};
+	static void push(std::shared_ptr< Mode > const &, bool overlay = false);
+	static void pop(); //remove the top mode
+	bool overlay = false; //set by push()
+
+	//main loop entry points; each walks the visible part of the stack -- the top mode and the
+	// modes under it down to (and including) the first one that isn't an overlay:
+	static bool stack_handle_event(SDL_Event const &, glm::uvec2 const &window_size); //top down, until handled
+	static void stack_update(float elapsed); //bottom up
+	static void stack_draw(glm::uvec2 const &drawable_size); //bottom up, so overlays draw last
 
+	//----- preloading -----
+	//A mode being constructed on another thread (modes keep no GL objects of their own --
+	// they draw through the shared Renderer -- so nothing is left to do when it's taken):
+	template< typename M >
+	struct Preloaded {
+		std::future< std::shared_ptr< M > > loading;
+
+		bool valid() const { return loading.valid(); }
+		bool ready() const {
+			return loading.valid() && loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+		//waits if still loading; rethrows anything make() threw:
+		std::shared_ptr< M > take() {
+			assert(loading.valid());
+			return loading.get();
+		}
+	};
+
+	//run 'make' (returning a std::shared_ptr< M >) on another thread:
+	//NOTE: 'make' and M's constructor must not touch OpenGL.
+	template< typename M, typename F >
+	static Preloaded< M > preload(F make) {
+		Preloaded< M > ret;
+		ret.loading = std::async(std::launch::async, make);
+		return ret;
+	}
+};
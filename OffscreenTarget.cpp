@@ -0,0 +1,52 @@
+#include "OffscreenTarget.hpp"
+
+#include "gl_errors.hpp"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+OffscreenTarget::OffscreenTarget(glm::uvec2 const &size_) : size(size_) {
+	glGenRenderbuffers(1, &color);
+	glBindRenderbuffer(GL_RENDERBUFFER, color);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, GLsizei(size.x), GLsizei(size.y));
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	GL_ERRORS();
+
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &color);
+		throw std::runtime_error("Offscreen framebuffer (" + std::to_string(size.x) + "x" + std::to_string(size.y) + ") is incomplete (status " + std::to_string(status) + ").");
+	}
+}
+
+OffscreenTarget::~OffscreenTarget() {
+	glDeleteFramebuffers(1, &framebuffer);
+	framebuffer = 0;
+
+	glDeleteRenderbuffers(1, &color);
+	color = 0;
+}
+
+void OffscreenTarget::bind() {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, GLsizei(size.x), GLsizei(size.y));
+}
+
+void OffscreenTarget::read_pixels(std::vector< glm::u8vec4 > *data_) const {
+	assert(data_);
+	auto &data = *data_;
+	data.resize(size.x * size.y);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, GLsizei(size.x), GLsizei(size.y), GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+	GL_ERRORS();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/*
+ * OffscreenTarget is a framebuffer object with an RGBA8 color renderbuffer,
+ *  used by main.cpp's --offscreen mode to render at a fixed size without
+ *  anything on screen (the window stays hidden and is never swapped).
+ */
+
+struct OffscreenTarget {
+	OffscreenTarget(glm::uvec2 const &size); //throws if the framebuffer is incomplete
+	~OffscreenTarget();
+	OffscreenTarget(OffscreenTarget const &) = delete;
+	OffscreenTarget &operator=(OffscreenTarget const &) = delete;
+
+	glm::uvec2 size;
+	GLuint framebuffer = 0;
+	GLuint color = 0; //renderbuffer
+
+	//draw (and read) into this target, with the viewport set to cover it:
+	void bind();
+
+	//read back the whole color buffer (lower-left origin, as save_png's LowerLeftOrigin expects):
+	void read_pixels(std::vector< glm::u8vec4 > *data) const;
+};
@@ -1,14 +1,22 @@
 #include "PongMode.hpp"
 
-//for the GL_ERRORS() macro:
-#include "gl_errors.hpp"
+//for PROFILE_ZONE():
+#include "Profiler.hpp"
 
-//for glm::value_ptr() :
-#include <glm/gtc/type_ptr.hpp>
+//for swept_box_vs_box():
+#include "collide.hpp"
+#include "kernels.hpp"
 
-#include <random>
+//for snapshots:
+#include "read_write_chunk.hpp"
+#include <sstream>
+#include <algorithm>
+
+#include <cassert>
+
+PongMode::PongMode(uint32_t seed, std::shared_ptr< Renderer > const &renderer_) : mt(seed), renderer(renderer_) {
+	assert(renderer && "PongMode draws with a shared Renderer");
 
-PongMode::PongMode() {
     balls.emplace_back(glm::vec2(0.0f, 0.0f));
     ball_velocities.emplace_back(glm::vec2(-1.0f, 0.0f));
     ball_trails.emplace_back(std::deque< glm::vec3 >());
@@ -20,133 +28,53 @@ PongMode::PongMode() {
     // ball_trails.emplace_back(std::deque< glm::vec3 >());
 
 	//set up trail as if ball has been here for 'forever':
-    for(int i = 0; i < balls.size(); i++) {
+    for(uint32_t i = 0; i < balls.size(); i++) {
         ball_trails[i].clear();
         ball_trails[i].emplace_back(balls[i], trail_length);
         ball_trails[i].emplace_back(balls[i], 0.0f);
     }
-
-	//----- allocate OpenGL resources -----
-	{ //vertex buffer:
-		glGenBuffers(1, &vertex_buffer);
-		//for now, buffer will be un-filled.
-
-		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
-	}
-
-	{ //vertex array mapping buffer for color_texture_program:
-		//ask OpenGL to fill vertex_buffer_for_color_texture_program with the name of an unused vertex array object:
-		glGenVertexArrays(1, &vertex_buffer_for_color_texture_program);
-
-		//set vertex_buffer_for_color_texture_program as the current vertex array object:
-		glBindVertexArray(vertex_buffer_for_color_texture_program);
-
-		//set vertex_buffer as the source of glVertexAttribPointer() commands:
-		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
-
-		//set up the vertex array object to describe arrays of PongMode::Vertex:
-		glVertexAttribPointer(
-			color_texture_program.Position_vec4, //attribute
-			3, //size
-			GL_FLOAT, //type
-			GL_FALSE, //normalized
-			sizeof(Vertex), //stride
-			(GLbyte *)0 + 0 //offset
-		);
-		glEnableVertexAttribArray(color_texture_program.Position_vec4);
-		//[Note that it is okay to bind a vec3 input to a vec4 attribute -- the w component will be filled with 1.0 automatically]
-
-		glVertexAttribPointer(
-			color_texture_program.Color_vec4, //attribute
-			4, //size
-			GL_UNSIGNED_BYTE, //type
-			GL_TRUE, //normalized
-			sizeof(Vertex), //stride
-			(GLbyte *)0 + 4*3 //offset
-		);
-		glEnableVertexAttribArray(color_texture_program.Color_vec4);
-
-		glVertexAttribPointer(
-			color_texture_program.TexCoord_vec2, //attribute
-			2, //size
-			GL_FLOAT, //type
-			GL_FALSE, //normalized
-			sizeof(Vertex), //stride
-			(GLbyte *)0 + 4*3 + 4*1 //offset
-		);
-		glEnableVertexAttribArray(color_texture_program.TexCoord_vec2);
-
-		//done referring to vertex_buffer, so unbind it:
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-		//done setting up vertex array object, so unbind it:
-		glBindVertexArray(0);
-
-		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
-	}
-
-	{ //solid white texture:
-		//ask OpenGL to fill white_tex with the name of an unused texture object:
-		glGenTextures(1, &white_tex);
-
-		//bind that texture object as a GL_TEXTURE_2D-type texture:
-		glBindTexture(GL_TEXTURE_2D, white_tex);
-
-		//upload a 1x1 image of solid white to the texture:
-		glm::uvec2 size = glm::uvec2(1,1);
-		std::vector< glm::u8vec4 > data(size.x*size.y, glm::u8vec4(0xff, 0xff, 0xff, 0xff));
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
-
-		//set filtering and wrapping parameters:
-		//(it's a bit silly to mipmap a 1x1 texture, but I'm doing it because you may want to use this code to load different sizes of texture)
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-		//since texture uses a mipmap and we haven't uploaded one, instruct opengl to make one for us:
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		//Okay, texture uploaded, can unbind it:
-		glBindTexture(GL_TEXTURE_2D, 0);
-
-		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
-	}
 }
 
 PongMode::~PongMode() {
-
-	//----- free OpenGL resources -----
-	glDeleteBuffers(1, &vertex_buffer);
-	vertex_buffer = 0;
-
-	glDeleteVertexArrays(1, &vertex_buffer_for_color_texture_program);
-	vertex_buffer_for_color_texture_program = 0;
-
-	glDeleteTextures(1, &white_tex);
-	white_tex = 0;
 }
 
 bool PongMode::handle_event(SDL_Event const &evt, glm::uvec2 const &window_size) {
+	mouse_window_size = window_size;
 
 	if (evt.type == SDL_MOUSEMOTION) {
-		//convert mouse from window pixels (top-left origin, +y is down) to clip space ([-1,1]x[-1,1], +y is up):
-		glm::vec2 clip_mouse = glm::vec2(
-			(evt.motion.x + 0.5f) / window_size.x * 2.0f - 1.0f,
-			(evt.motion.y + 0.5f) / window_size.y *-2.0f + 1.0f
-		);
-		left_paddle.y = (clip_to_court * glm::vec3(clip_mouse, 1.0f)).y;
+		//just remember the newest position; apply_mouse() does the mapping once per frame:
+		mouse_pending = true;
+		mouse_window = glm::vec2(evt.motion.x, evt.motion.y);
 	}
 
 	return false;
 }
 
-void PongMode::update(float elapsed) {
+void PongMode::apply_mouse() {
+	if (!mouse_pending) return;
+	mouse_pending = false;
+	set_paddle_from_mouse(mouse_window, mouse_window_size);
+}
+
+void PongMode::set_paddle_from_mouse(glm::vec2 const &window_px, glm::uvec2 const &window_size) {
+	if (window_size.x == 0 || window_size.y == 0) return;
+	//convert mouse from window pixels (top-left origin, +y is down) to clip space ([-1,1]x[-1,1], +y is up):
+	glm::vec2 clip_mouse = glm::vec2(
+		(window_px.x + 0.5f) / window_size.x * 2.0f - 1.0f,
+		(window_px.y + 0.5f) / window_size.y *-2.0f + 1.0f
+	);
+	left_paddle.y = (clip_to_court * glm::vec3(clip_mouse, 1.0f)).y;
 
-	static std::mt19937 mt; //mersenne twister pseudo-random number generator
+	//(update() clamps too, but a late sample is drawn before the next update)
+	left_paddle.y = std::max(left_paddle.y, -court_radius.y + paddle_radius.y);
+	left_paddle.y = std::min(left_paddle.y,  court_radius.y - paddle_radius.y);
+}
+
+void PongMode::update(float elapsed) {
 
 	//----- paddle update -----
     {
+        PROFILE_ZONE("update.spawn");
         block_update += elapsed;
         if(block_update > block_spawn) {
             block_update -= block_spawn;
@@ -185,6 +113,7 @@ void PongMode::update(float elapsed) {
     }
 
 	{ //right player ai:
+		PROFILE_ZONE("update.ai");
 		ai_offset_update -= elapsed;
 		if (ai_offset_update < elapsed) {
 			//update again in [0.5,1.0) seconds:
@@ -210,135 +139,73 @@ void PongMode::update(float elapsed) {
 	//speed of ball doubles every four points:
 	float speed_multiplier = 4.0f * std::pow(2.0f, (left_score + right_score) / 4.0f);
 
-	//velocity cap, though (otherwise ball can pass through paddles):
-	speed_multiplier = std::min(speed_multiplier, 10.0f);
-
-    for(int i = 0; i < balls.size(); i++) {
-	    balls[i] += elapsed * speed_multiplier * ball_velocities[i];
-    }
-
-	//---- collision handling ----
-    auto obj_vs_balls = [this](glm::vec2 const &obj, glm::vec2 const &obj_radius) {
-        bool hitSomething = false;
-        for(int i = 0; i < balls.size(); i++) {
-            //compute area of overlap:
-            glm::vec2 min = glm::max(obj - obj_radius, balls[i] - ball_radius);
-            glm::vec2 max = glm::min(obj + obj_radius, balls[i] + ball_radius);
-
-            //if no overlap, no collision:
-            if (min.x > max.x || min.y > max.y) continue;
-
-            if (max.x - min.x > max.y - min.y) {
-                //wider overlap in x => bounce in y direction:
-                if (balls[i].y > obj.y) {
-                    balls[i].y = obj.y + obj_radius.y + ball_radius.y;
-                    ball_velocities[i].y = std::abs(ball_velocities[i].y);
-                } else {
-                    balls[i].y = obj.y - obj_radius.y - ball_radius.y;
-                    ball_velocities[i].y = -std::abs(ball_velocities[i].y);
-                }
-            } else {
-                //wider overlap in y => bounce in x direction:
-                if (balls[i].x > obj.x) {
-                    balls[i].x = obj.x + obj_radius.x + ball_radius.x;
-                    ball_velocities[i].x = std::abs(ball_velocities[i].x);
-                } else {
-                    balls[i].x = obj.x - paddle_radius.x - ball_radius.x;
-                    ball_velocities[i].x = -std::abs(ball_velocities[i].x);
-                }
-                //warp y velocity based on offset from paddle center:
-                float vel = (balls[i].y - obj.y) / (obj_radius.y + ball_radius.y);
-                ball_velocities[i].y = glm::mix(ball_velocities[i].y, vel, 0.75f);
-            }
-
-            hitSomething = true;
-        }
+	//velocity cap, though -- balls are swept, so this is no longer about passing through paddles,
+	//just about keeping the doubling from running away (to unplayable speeds and, eventually, infinity):
+	speed_multiplier = std::min(speed_multiplier, max_speed_multiplier);
+
+	//---- ball movement + collision handling ----
+	ProfileZone collide_zone("update.collide");
+
+	//block hits and scoring take effect once every ball has moved:
+	blocks_hit.assign(blocks.size(), 0);
+	uint32_t left_scored = 0;
+	uint32_t right_scored = 0;
+
+	if (event_driven) {
+		//only balls with a collision due this step get tested:
+		scheduler.step(*this, speed_multiplier, elapsed, &left_scored, &right_scored);
+	} else {
+		float scale = elapsed * speed_multiplier;
+
+		//paddles sit at fixed x, so first (in bulk) find the balls that could reach one this step:
+		near_paddle.resize(balls.size());
+		paddle_slab_candidates(balls.data(), ball_velocities.data(), uint32_t(balls.size()),
+			scale, ball_radius.x,
+			glm::vec2(left_paddle.x - paddle_radius.x, left_paddle.x + paddle_radius.x),
+			glm::vec2(right_paddle.x - paddle_radius.x, right_paddle.x + paddle_radius.x),
+			near_paddle.data());
+
+		//...and only test those against the paddles:
+		for (uint32_t i = 0; i < balls.size(); ++i) {
+			move_ball(i, scale, &left_scored, &right_scored, near_paddle[i] != 0);
+		}
+	}
 
-        return hitSomething;
+	//blocks:
+	apply_block_hits();
+
+	//scoring:
+	auto shrink_court = [this]() {
+		//Shrink the walls, making it harder to defend
+		if(court_radius.x > 3.5f && court_radius.y > 2.5f)
+		{
+			court_radius -= glm::vec2(0.7f, 0.5f);
+			paddle_radius -= glm::vec2(0.02f, 0.1f);
+			ball_radius -= glm::vec2(0.02f, 0.02f);
+			left_paddle += glm::vec2(0.7f - 0.05f, 0);
+			right_paddle -= glm::vec2(0.7f + 0.05f, 0);
+			trail_length -= 0.13f;
+
+			//Remove all blocks instead of re-placing them because I am bad at math
+			blocks.clear();
+		}
 	};
+	for (uint32_t s = 0; s < left_scored; ++s) {
+		left_score += 1;
+		shrink_court();
+	}
+	for (uint32_t s = 0; s < right_scored; ++s) {
+		right_score += 1;
+		shrink_court();
+	}
 
-	//paddles:
-	obj_vs_balls(left_paddle, paddle_radius);
-	obj_vs_balls(right_paddle, paddle_radius);
-
-    //blocks:
-	for(int counter = 0; counter < blocks.size(); counter++) {
-        if(obj_vs_balls(blocks[counter].pos, block_radius)) {
-            do_effect(blocks[counter]);
-
-            //Shrinking or expanding removes all blocks, so break
-            if(!blocks.empty()) {
-                blocks.erase(blocks.begin() + counter);
-                counter--;
-            }
-            else
-                break;
-        }
-    }
-
-	//court walls:
-    for(int i = 0; i < balls.size(); i++) {
-        if (balls[i].y > court_radius.y - ball_radius.y) {
-            balls[i].y = court_radius.y - ball_radius.y;
-            if (ball_velocities[i].y > 0.0f) {
-                ball_velocities[i].y = -ball_velocities[i].y;
-            }
-        }
-        if (balls[i].y < -court_radius.y + ball_radius.y) {
-            balls[i].y = -court_radius.y + ball_radius.y;
-            if (ball_velocities[i].y < 0.0f) {
-                ball_velocities[i].y = -ball_velocities[i].y;
-            }
-        }
-
-        if (balls[i].x > court_radius.x - ball_radius.x) {
-            balls[i].x = court_radius.x - ball_radius.x;
-            if (ball_velocities[i].x > 0.0f) {
-                ball_velocities[i].x = -ball_velocities[i].x;
-                left_score += 1;
-
-                //Shrink the walls, making it harder to defend
-                if(court_radius.x > 3.5f && court_radius.y > 2.5f)
-                {
-                    court_radius -= glm::vec2(0.7f, 0.5f);
-                    paddle_radius -= glm::vec2(0.02f, 0.1f);
-                    ball_radius -= glm::vec2(0.02f, 0.02f);
-                    left_paddle += glm::vec2(0.7f - 0.05f, 0);
-                    right_paddle -= glm::vec2(0.7f + 0.05f, 0);
-                    trail_length -= 0.13f;
-
-                    //Remove all blocks instead of re-placing them because I am bad at math
-                    blocks.clear();
-                }
-            }
-        }
-        if (balls[i].x < -court_radius.x + ball_radius.x) {
-            balls[i].x = -court_radius.x + ball_radius.x;
-            if (ball_velocities[i].x < 0.0f) {
-                ball_velocities[i].x = -ball_velocities[i].x;
-                right_score += 1;
-
-                //Shrink the walls, making it harder to defend
-                if(court_radius.x > 3.5f && court_radius.y > 2.5f)
-                {
-                    court_radius -= glm::vec2(0.7f, 0.5f);
-                    paddle_radius -= glm::vec2(0.02f, 0.1f);
-                    ball_radius -= glm::vec2(0.02f, 0.02f);
-                    left_paddle += glm::vec2(0.7f - 0.05f, 0);
-                    right_paddle -= glm::vec2(0.7f + 0.05f, 0);
-                    trail_length -= 0.13f;
-                    
-                    //Remove all blocks instead of re-placing them because I am bad at math
-                    blocks.clear();
-                }
-            }
-        }
-    }
+	collide_zone.end();
 
 	//----- gradient trails -----
+	PROFILE_ZONE("update.trails");
 
 	//age up all locations in ball trail:
-    for(int i = 0; i < balls.size(); i++) {
+    for(uint32_t i = 0; i < balls.size(); i++) {
         for (auto &t : ball_trails[i]) {
             t.z += elapsed;
         }
@@ -354,6 +221,15 @@ void PongMode::update(float elapsed) {
     }
 }
 
+//draw rectangle as a CCW-oriented quad -- Renderer's quad index buffer makes the two triangles (V is Vertex or CompactVertex):
+template< typename V >
+static void push_rectangle(std::vector< V > &vertices, glm::vec2 const &center, glm::vec2 const &radius, glm::u8vec4 const &color) {
+	vertices.emplace_back(glm::vec2(center.x-radius.x, center.y-radius.y), color);
+	vertices.emplace_back(glm::vec2(center.x+radius.x, center.y-radius.y), color);
+	vertices.emplace_back(glm::vec2(center.x+radius.x, center.y+radius.y), color);
+	vertices.emplace_back(glm::vec2(center.x-radius.x, center.y+radius.y), color);
+}
+
 void PongMode::draw(glm::uvec2 const &drawable_size) {
 	//some nice colors from the course web page:
 	#define HEX_TO_U8VEC4( HX ) (glm::u8vec4( (HX >> 24) & 0xff, (HX >> 16) & 0xff, (HX >> 8) & 0xff, (HX) & 0xff ))
@@ -373,22 +249,74 @@ void PongMode::draw(glm::uvec2 const &drawable_size) {
 	const float wall_radius = 0.05f;
 	const float shadow_offset = 0.07f;
 	const float padding = 0.14f; //padding between outside of walls and edge of window
+	const glm::vec2 score_radius = glm::vec2(0.1f, 0.1f);
+
+	//------ compute court-to-window transform ------
+
+	//compute area that should be visible:
+	glm::vec2 scene_min = glm::vec2(
+		-court_radius.x - 2.0f * wall_radius - padding,
+		-court_radius.y - 2.0f * wall_radius - padding
+	);
+	glm::vec2 scene_max = glm::vec2(
+		court_radius.x + 2.0f * wall_radius + padding,
+		court_radius.y + 2.0f * wall_radius + 3.0f * score_radius.y + padding
+	);
+
+	//compute window aspect ratio:
+	float aspect = drawable_size.x / float(drawable_size.y);
+	//we'll scale the x coordinate by 1.0 / aspect to make sure things stay square.
+
+	//compute scale factor for court given that...
+	float scale = std::min(
+		(2.0f * aspect) / (scene_max.x - scene_min.x), //... x must fit in [-aspect,aspect] ...
+		(2.0f) / (scene_max.y - scene_min.y) //... y must fit in [-1,1].
+	);
+
+	glm::vec2 center = 0.5f * (scene_max + scene_min);
+
+	//build matrix that scales and translates appropriately:
+	glm::mat4 court_to_clip = glm::mat4(
+		glm::vec4(scale / aspect, 0.0f, 0.0f, 0.0f),
+		glm::vec4(0.0f, scale, 0.0f, 0.0f),
+		glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+		glm::vec4(-center.x * (scale / aspect), -center.y * scale, 0.0f, 1.0f)
+	);
+	//NOTE: glm matrices are specified in *Column-Major* order,
+	// so each line above is specifying a *column* of the matrix(!)
+
+	//also build the matrix that takes clip coordinates to court coordinates (used for mouse handling):
+	clip_to_court = glm::mat3x2(
+		glm::vec2(aspect / scale, 0.0f),
+		glm::vec2(0.0f, 1.0f / scale),
+		glm::vec2(center.x, center.y)
+	);
+
+	//---- late input ----
+	//(the paddle is the only thing drawn from input, so sample it as close to vertex generation as possible)
+	if (late_mouse && mouse_window_size != glm::uvec2(0) && SDL_GetMouseFocus()) {
+		//SDL_GetMouseState reports the position as of the last event pump (the event step, early
+		// in the frame), so pump again first -- otherwise this is the position apply_mouse() already used:
+		SDL_PumpEvents();
+		int x, y;
+		SDL_GetMouseState(&x, &y);
+		late_mouse_counter = SDL_GetPerformanceCounter();
+		mouse_pending = false; //(anything queued is older than this)
+		set_paddle_from_mouse(glm::vec2(x, y), mouse_window_size);
+	}
 
 	//---- compute vertices to draw ----
+	ProfileZone vertices_zone("draw.vertices");
 
-	//vertices will be accumulated into this list and then uploaded+drawn at the end of this function:
-	std::vector< Vertex > vertices;
+	//vertices are accumulated into one of the layer's batches (depending on compact_vertices); renderer->flush() draws them at the end of the frame:
+	Renderer::Layer layer = renderer->layer(court_to_clip);
+	std::vector< Vertex > *vertices = (compact_vertices ? nullptr : &renderer->quads(layer));
+	std::vector< CompactVertex > *compact = (compact_vertices ? &renderer->compact_quads(layer) : nullptr);
 
 	//inline helper function for rectangle drawing:
-	auto draw_rectangle = [&vertices](glm::vec2 const &center, glm::vec2 const &radius, glm::u8vec4 const &color) {
-		//draw rectangle as two CCW-oriented triangles:
-		vertices.emplace_back(glm::vec3(center.x-radius.x, center.y-radius.y, 0.0f), color, glm::vec2(0.5f, 0.5f));
-		vertices.emplace_back(glm::vec3(center.x+radius.x, center.y-radius.y, 0.0f), color, glm::vec2(0.5f, 0.5f));
-		vertices.emplace_back(glm::vec3(center.x+radius.x, center.y+radius.y, 0.0f), color, glm::vec2(0.5f, 0.5f));
-
-		vertices.emplace_back(glm::vec3(center.x-radius.x, center.y-radius.y, 0.0f), color, glm::vec2(0.5f, 0.5f));
-		vertices.emplace_back(glm::vec3(center.x+radius.x, center.y+radius.y, 0.0f), color, glm::vec2(0.5f, 0.5f));
-		vertices.emplace_back(glm::vec3(center.x-radius.x, center.y+radius.y, 0.0f), color, glm::vec2(0.5f, 0.5f));
+	auto draw_rectangle = [&](glm::vec2 const &center, glm::vec2 const &radius, glm::u8vec4 const &color) {
+		if (compact_vertices) push_rectangle(*compact, center, radius, color);
+		else push_rectangle(*vertices, center, radius, color);
 	};
 
 	//shadows for everything (except the trail):
@@ -401,9 +329,10 @@ void PongMode::draw(glm::uvec2 const &drawable_size) {
 	// draw_rectangle(left_paddle+s, paddle_radius, shadow_color);
 	// draw_rectangle(right_paddle+s, paddle_radius, shadow_color);
 	// draw_rectangle(ball+s, ball_radius, shadow_color);
+	(void)shadow_color; (void)shadow_offset; //(only used by the shadows above, which are turned off)
 
 	//ball's trail:
-    for(int i = 0; i < balls.size(); i++) {
+    for(uint32_t i = 0; i < balls.size(); i++) {
         if (ball_trails[i].size() >= 2) {
             //start ti at second element so there is always something before it to interpolate from:
             std::deque< glm::vec3 >::iterator ti = ball_trails[i].begin() + 1;
@@ -462,9 +391,8 @@ void PongMode::draw(glm::uvec2 const &drawable_size) {
 	
 
 	//ball:
-    for(auto ball : balls) {
-	    draw_rectangle(ball, ball_radius, fg_color);
-    }
+	if (compact_vertices) pack_rectangles(balls.data(), uint32_t(balls.size()), ball_radius, fg_color, compact);
+	else pack_rectangles(balls.data(), uint32_t(balls.size()), ball_radius, fg_color, vertices);
 
     //Left blocks
     for(auto block: blocks) {
@@ -472,7 +400,6 @@ void PongMode::draw(glm::uvec2 const &drawable_size) {
     }
 
 	//scores:
-	glm::vec2 score_radius = glm::vec2(0.1f, 0.1f);
 	for (uint32_t i = 0; i < left_score; ++i) {
 		draw_rectangle(glm::vec2( -court_radius.x + (2.0f + 3.0f * i) * score_radius.x, court_radius.y + 2.0f * wall_radius + 2.0f * score_radius.y), score_radius, left_color);
 	}
@@ -480,172 +407,402 @@ void PongMode::draw(glm::uvec2 const &drawable_size) {
 		draw_rectangle(glm::vec2( court_radius.x - (2.0f + 3.0f * i) * score_radius.x, court_radius.y + 2.0f * wall_radius + 2.0f * score_radius.y), score_radius, right_color);
 	}
 
-	//------ compute court-to-window transform ------
+	vertices_zone.end();
 
-	//compute area that should be visible:
-	glm::vec2 scene_min = glm::vec2(
-		-court_radius.x - 2.0f * wall_radius - padding,
-		-court_radius.y - 2.0f * wall_radius - padding
-	);
-	glm::vec2 scene_max = glm::vec2(
-		court_radius.x + 2.0f * wall_radius + padding,
-		court_radius.y + 2.0f * wall_radius + 3.0f * score_radius.y + padding
-	);
+	//---- actual drawing ----
+	//(the clear happens now; everything else when main.cpp flushes the renderer)
+	renderer->clear(bg_color);
+}
 
-	//compute window aspect ratio:
-	float aspect = drawable_size.x / float(drawable_size.y);
-	//we'll scale the x coordinate by 1.0 / aspect to make sure things stay square.
+void PongMode::move_ball(uint32_t i, float scale, uint32_t *left_scored, uint32_t *right_scored, bool paddles) {
+	//move in straight lines between collisions, resolving them in time-of-impact order:
+	float remaining = 1.0f; //fraction of this step's motion still to do
+	Hit last;
+	for (uint32_t bounce = 0; bounce < MaxBounces; ++bounce) {
+		glm::vec2 delta = (remaining * scale) * ball_velocities[i];
+		Hit hit = sweep(balls[i], delta, last, paddles);
+		if (hit.kind == Hit::None) {
+			balls[i] += delta;
+			break;
+		}
+		balls[i] += hit.time * delta;
+		remaining *= 1.0f - hit.time;
+		if (resolve(i, hit)) {
+			if (hit.kind == Hit::LeftWall) *right_scored += 1;
+			if (hit.kind == Hit::RightWall) *left_scored += 1;
+		}
+		//time-zero hits can move the ball without velocity (pushed out of an overlap, clamped to a wall),
+		// so the paddle_slab_candidates() bound no longer holds for the rest of the step:
+		if (hit.time == 0.0f) paddles = true;
+		last = hit;
+	}
+}
 
-	//compute scale factor for court given that...
-	float scale = std::min(
-		(2.0f * aspect) / (scene_max.x - scene_min.x), //... x must fit in [-aspect,aspect] ...
-		(2.0f) / (scene_max.y - scene_min.y) //... y must fit in [-1,1].
-	);
+PongMode::Hit PongMode::sweep(glm::vec2 const &at, glm::vec2 const &delta, Hit const &ignore, bool paddles) const {
+	Hit first;
+	float time = 0.0f;
+	glm::vec2 normal;
+
+	//paddles and blocks are boxes:
+	//'back' is the x direction of a paddle's back face (0 for blocks):
+	auto test_box = [&](Hit::Kind kind, uint32_t block, glm::vec2 const &box, glm::vec2 const &box_radius, float back) {
+		if (kind == ignore.kind && block == ignore.block) return;
+		if (!swept_box_vs_box(at, delta, ball_radius, box, box_radius, &time, &normal)) return;
+		//the gap behind a paddle is narrower than a ball, so a ball the paddle moved onto goes out the front
+		// (out the back, it would be pinned between paddle and wall):
+		if (back != 0.0f && time == 0.0f && normal.x == back) normal = glm::vec2(-back, 0.0f);
+		if (first.kind != Hit::None && time >= first.time) return;
+		first.kind = kind;
+		first.block = block;
+		first.time = time;
+		first.normal = normal;
+	};
+	if (paddles) {
+		test_box(Hit::LeftPaddle, 0, left_paddle, paddle_radius, -1.0f);
+		test_box(Hit::RightPaddle, 0, right_paddle, paddle_radius, 1.0f);
+	}
+	for (uint32_t b = 0; b < blocks.size(); ++b) {
+		test_box(Hit::BlockHit, b, blocks[b].pos, block_radius, 0.0f);
+	}
 
-	glm::vec2 center = 0.5f * (scene_max + scene_min);
+	//walls are planes at which the ball's center stops (already being past one counts as a hit at time zero):
+	auto test_wall = [&](Hit::Kind kind, int axis, float limit, float direction) {
+		if (kind == ignore.kind) return;
+		float distance = direction * (limit - at[axis]); //how far the ball can go before touching
+		float speed = direction * delta[axis];
+		if (distance <= 0.0f) {
+			//resting against the wall and not heading into it (e.g., just clamped into a corner):
+			if (distance == 0.0f && speed <= 0.0f) return;
+			time = 0.0f;
+		} else {
+			if (speed <= distance) return; //doesn't reach the wall this step
+			time = distance / speed;
+		}
+		if (first.kind != Hit::None && time >= first.time) return;
+		first.kind = kind;
+		first.block = 0;
+		first.time = time;
+		first.normal = glm::vec2(0.0f);
+		first.normal[axis] = -direction;
+	};
+	test_wall(Hit::TopWall, 1, court_radius.y - ball_radius.y, 1.0f);
+	test_wall(Hit::BottomWall, 1, -court_radius.y + ball_radius.y, -1.0f);
+	test_wall(Hit::RightWall, 0, court_radius.x - ball_radius.x, 1.0f);
+	test_wall(Hit::LeftWall, 0, -court_radius.x + ball_radius.x, -1.0f);
 
-	//build matrix that scales and translates appropriately:
-	glm::mat4 court_to_clip = glm::mat4(
-		glm::vec4(scale / aspect, 0.0f, 0.0f, 0.0f),
-		glm::vec4(0.0f, scale, 0.0f, 0.0f),
-		glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
-		glm::vec4(-center.x * (scale / aspect), -center.y * scale, 0.0f, 1.0f)
-	);
-	//NOTE: glm matrices are specified in *Column-Major* order,
-	// so each line above is specifying a *column* of the matrix(!)
+	return first;
+}
 
-	//also build the matrix that takes clip coordinates to court coordinates (used for mouse handling):
-	clip_to_court = glm::mat3x2(
-		glm::vec2(aspect / scale, 0.0f),
-		glm::vec2(0.0f, 1.0f / scale),
-		glm::vec2(center.x, center.y)
-	);
+bool PongMode::resolve(uint32_t i, Hit const &hit) {
+	glm::vec2 &ball = balls[i];
+	glm::vec2 &velocity = ball_velocities[i];
+	int axis = (hit.normal.x != 0.0f ? 0 : 1);
+
+	if (hit.kind == Hit::TopWall || hit.kind == Hit::BottomWall
+	 || hit.kind == Hit::LeftWall || hit.kind == Hit::RightWall) {
+		//clamp to the wall; bounce (and, for the side walls, score) only if heading out:
+		float limit = (axis == 0 ? court_radius.x - ball_radius.x : court_radius.y - ball_radius.y);
+		ball[axis] = -hit.normal[axis] * limit;
+		if (velocity[axis] * hit.normal[axis] < 0.0f) {
+			velocity[axis] = -velocity[axis];
+			return true;
+		}
+		return false;
+	}
 
-	//---- actual drawing ----
+	//paddle or block: move to its surface and bounce off:
+	glm::vec2 obj, obj_radius;
+	if (hit.kind == Hit::LeftPaddle) {
+		obj = left_paddle;
+		obj_radius = paddle_radius;
+	} else if (hit.kind == Hit::RightPaddle) {
+		obj = right_paddle;
+		obj_radius = paddle_radius;
+	} else {
+		obj = blocks[hit.block].pos;
+		obj_radius = block_radius;
+		blocks_hit[hit.block] = 1;
+	}
 
-	//clear the color buffer:
-	glClearColor(bg_color.r / 255.0f, bg_color.g / 255.0f, bg_color.b / 255.0f, bg_color.a / 255.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
+	ball[axis] = obj[axis] + hit.normal[axis] * (obj_radius[axis] + ball_radius[axis]);
+	velocity[axis] = hit.normal[axis] * std::abs(velocity[axis]);
+	if (axis == 0) {
+		//warp y velocity based on offset from paddle center:
+		float vel = (ball.y - obj.y) / (obj_radius.y + ball_radius.y);
+		velocity.y = glm::mix(velocity.y, vel, 0.75f);
+	}
+	return true;
+}
 
-	//use alpha blending:
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	//don't use the depth test:
-	glDisable(GL_DEPTH_TEST);
+//----- block effects -----
 
-	//upload vertices to vertex_buffer:
-	glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer); //set vertex_buffer as current
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(vertices[0]), vertices.data(), GL_STREAM_DRAW); //upload vertices array
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+void BlockTraits< regular >::apply(PongMode &, uint32_t) {
+}
 
-	//set color_texture_program as current program:
-	glUseProgram(color_texture_program.program);
+void BlockTraits< split >::apply(PongMode &pong, uint32_t count) {
+	//each hit doubles every ball on screen (the copy flies in the opposite y direction),
+	// so 'count' hits turn each ball into 2^count copies (capped at 2^16); copy 'c' is flipped once per set bit:
+	uint32_t copies = 1u << std::min(count, 16u);
+	//...but never past MaxBalls in all:
+	while (copies > 1 && uint64_t(pong.balls.size()) * copies > PongMode::MaxBalls) copies /= 2;
+	std::vector< glm::vec2 > new_balls;
+	std::vector< glm::vec2 > new_velocities;
+	std::vector< std::deque< glm::vec3 > > new_trails;
+	new_balls.reserve(pong.balls.size() * copies);
+	new_velocities.reserve(pong.balls.size() * copies);
+	new_trails.reserve(pong.balls.size() * copies);
+	for (uint32_t i = 0; i < pong.balls.size(); ++i) {
+		glm::vec2 flipped = pong.ball_velocities[i] * glm::vec2(1.0f, -1.0f);
+		for (uint32_t c = 0; c < copies; ++c) {
+			uint32_t bits = 0;
+			for (uint32_t b = c; b; b &= b - 1) ++bits;
+			new_balls.emplace_back(pong.balls[i]);
+			new_velocities.emplace_back((bits & 1) ? flipped : pong.ball_velocities[i]);
+			new_trails.emplace_back(pong.ball_trails[i]);
+		}
+	}
+	pong.balls = std::move(new_balls);
+	pong.ball_velocities = std::move(new_velocities);
+	pong.ball_trails = std::move(new_trails);
+}
 
-	//upload OBJECT_TO_CLIP to the proper uniform location:
-	glUniformMatrix4fv(color_texture_program.OBJECT_TO_CLIP_mat4, 1, GL_FALSE, glm::value_ptr(court_to_clip));
+void BlockTraits< del >::apply(PongMode &pong, uint32_t count) {
+	//each hit removes the newest half of the balls:
+	size_t size = pong.balls.size();
+	for (uint32_t c = 0; c < count && size; ++c) {
+		size -= size / 2;
+	}
+	pong.balls.resize(size);
+	pong.ball_velocities.resize(size);
+	pong.ball_trails.resize(size);
+}
 
-	//use the mapping vertex_buffer_for_color_texture_program to fetch vertex data:
-	glBindVertexArray(vertex_buffer_for_color_texture_program);
+void BlockTraits< leftScore >::apply(PongMode &pong, uint32_t count) {
+	pong.left_score += count;
+}
 
-	//bind the solid white texture to location zero so things will be drawn just with their colors:
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, white_tex);
+void BlockTraits< rightScore >::apply(PongMode &pong, uint32_t count) {
+	pong.right_score += count;
+}
 
-	//run the OpenGL pipeline:
-	glDrawArrays(GL_TRIANGLES, 0, GLsizei(vertices.size()));
+void BlockTraits< shrink >::apply(PongMode &pong, uint32_t) {
+	pong.court_radius = glm::vec2(3.5f, 2.5f);
+	pong.paddle_radius = glm::vec2(0.1f, 0.5f);
+	pong.ball_radius = glm::vec2(0.1f, 0.1f);
+	pong.left_paddle = glm::vec2(-3.25f, 0);
+	pong.right_paddle = glm::vec2(3.25f, 0);
+	pong.trail_length = 0.65f;
+	pong.blocks.clear();
+}
 
-	//unbind the solid white texture:
-	glBindTexture(GL_TEXTURE_2D, 0);
+void BlockTraits< expand >::apply(PongMode &pong, uint32_t) {
+	pong.court_radius = glm::vec2(7.0f, 5.0f);
+	pong.paddle_radius = glm::vec2(0.2f, 1.0f);
+	pong.ball_radius = glm::vec2(0.2f, 0.2f);
+	pong.left_paddle = glm::vec2(-pong.court_radius.x + 0.5f, 0.0f);
+	pong.right_paddle = glm::vec2( pong.court_radius.x - 0.5f, 0.0f);
+	pong.trail_length = 1.3f;
+	pong.blocks.clear();
+}
 
-	//reset vertex array to none:
-	glBindVertexArray(0);
+//applies one bucket; returns true if later buckets should be skipped:
+template< BLOCK_TYPE Type >
+static bool apply_bucket(PongMode &pong, uint32_t const *counts) {
+	if (counts[Type] == 0) return false;
+	BlockTraits< Type >::apply(pong, counts[Type]);
+	profiler.count(BlockTraits< Type >::Name, counts[Type]);
+	return BlockTraits< Type >::ClearsBlocks;
+}
 
-	//reset current program to none:
-	glUseProgram(0);
-	
+void PongMode::apply_block_hits() {
+	uint32_t counts[expand + 1] = { };
+	uint32_t total = 0;
+	for (uint32_t b = 0; b < blocks.size(); ++b) {
+		if (blocks_hit[b]) {
+			counts[blocks[b].type] += 1;
+			total += 1;
+		}
+	}
+	if (total == 0) return;
 
-	GL_ERRORS(); //PARANOIA: print errors just in case we did something wrong.
+	//remove the hit blocks first (effects that clear the blocks may leave nothing to compact):
+	uint32_t kept = 0;
+	for (uint32_t b = 0; b < blocks.size(); ++b) {
+		if (!blocks_hit[b]) blocks[kept++] = blocks[b];
+	}
+	blocks.erase(blocks.begin() + kept, blocks.end());
+	blocks_hit.assign(blocks.size(), 0);
+
+	//short-circuits after the first bucket that clears all blocks:
+	apply_bucket< regular >(*this, counts)
+	|| apply_bucket< split >(*this, counts)
+	|| apply_bucket< del >(*this, counts)
+	|| apply_bucket< leftScore >(*this, counts)
+	|| apply_bucket< rightScore >(*this, counts)
+	|| apply_bucket< shrink >(*this, counts)
+	|| apply_bucket< expand >(*this, counts);
+}
 
+//----- snapshots -----
+
+//fixed-size state, stored as a single 'scal' chunk element:
+struct SnapshotScalars {
+	glm::vec2 court_radius;
+	glm::vec2 paddle_radius;
+	glm::vec2 block_radius;
+	glm::vec2 ball_radius;
+	glm::vec2 left_paddle;
+	glm::vec2 right_paddle;
+	uint32_t left_score;
+	uint32_t right_score;
+	float ai_offset;
+	float ai_offset_update;
+	float block_spawn;
+	float block_update;
+	float trail_length;
+};
+static_assert(sizeof(SnapshotScalars) == 6*8 + 2*4 + 5*4, "SnapshotScalars should be packed");
+
+//Block without the constructor (so it can be bulk-read) and with a fixed-size type:
+struct SnapshotBlock {
+	glm::vec2 pos;
+	uint32_t type;
+};
+static_assert(sizeof(SnapshotBlock) == 8 + 4, "SnapshotBlock should be packed");
+static_assert(sizeof(glm::vec2) == 2*4 && sizeof(glm::vec3) == 3*4, "glm vectors should be packed");
+
+void PongMode::save_snapshot(std::ostream &to) const {
+	std::vector< uint32_t > header{ SnapshotVersion };
+	write_chunk("pong", header, &to);
+
+	std::vector< SnapshotScalars > scalars(1);
+	SnapshotScalars &s = scalars[0];
+	s.court_radius = court_radius;
+	s.paddle_radius = paddle_radius;
+	s.block_radius = block_radius;
+	s.ball_radius = ball_radius;
+	s.left_paddle = left_paddle;
+	s.right_paddle = right_paddle;
+	s.left_score = left_score;
+	s.right_score = right_score;
+	s.ai_offset = ai_offset;
+	s.ai_offset_update = ai_offset_update;
+	s.block_spawn = block_spawn;
+	s.block_update = block_update;
+	s.trail_length = trail_length;
+	write_chunk("scal", scalars, &to);
+
+	write_chunk("ball", balls, &to);
+	write_chunk("bvel", ball_velocities, &to);
+
+	//trails are deques, so store lengths + one flattened array:
+	std::vector< uint32_t > trail_lengths;
+	std::vector< glm::vec3 > trail_points;
+	trail_lengths.reserve(ball_trails.size());
+	for (auto const &trail : ball_trails) {
+		trail_lengths.emplace_back(uint32_t(trail.size()));
+		trail_points.insert(trail_points.end(), trail.begin(), trail.end());
+	}
+	write_chunk("tlen", trail_lengths, &to);
+	write_chunk("tpts", trail_points, &to);
+
+	std::vector< SnapshotBlock > snapshot_blocks;
+	snapshot_blocks.reserve(blocks.size());
+	for (auto const &block : blocks) {
+		snapshot_blocks.emplace_back(SnapshotBlock{block.pos, uint32_t(block.type)});
+	}
+	write_chunk("blck", snapshot_blocks, &to);
+
+	//the standard library only offers a text form of the generator state (~7k characters):
+	std::ostringstream mt_state;
+	mt_state << mt;
+	std::string mt_text = mt_state.str();
+	write_chunk("rng ", std::vector< char >(mt_text.begin(), mt_text.end()), &to);
 }
 
-void PongMode::do_effect(Block &block) {
-    std::cout << block.type << std::endl;
-    switch(block.type) {
-        case split: {
-            std::vector<glm::vec2> new_balls;
-            std::vector<glm::vec2> new_velocities;
-            std::vector<std::deque< glm::vec3 >> new_trails;
-
-            for(int i = 0; i < balls.size(); i++) {
-                //Double every ball on screen
-                new_balls.emplace_back(balls[i]);
-                new_balls.emplace_back(balls[i]);
-
-                //Add spawn a ball flying in the opposite direction
-                new_velocities.emplace_back(ball_velocities[i]);
-                new_velocities.emplace_back(ball_velocities[i] * glm::vec2(1, -1.0f));
-
-                //Add new trail
-                new_trails.emplace_back(ball_trails[i]);
-                new_trails.emplace_back(ball_trails[i]);
-            }
+void PongMode::load_snapshot(std::istream &from) {
+	std::vector< uint32_t > header;
+	read_chunk(from, "pong", &header);
+	if (header.size() != 1 || header[0] != SnapshotVersion) {
+		throw std::runtime_error("Unsupported snapshot version (expected " + std::to_string(SnapshotVersion) + ").");
+	}
 
-            balls = new_balls;
-            ball_velocities = new_velocities;
-            ball_trails = new_trails;
-            return;
-        }
-        case del: {
-            const auto halfSize = balls.size()/2;
-            for(auto i = 0; i < halfSize; i++) {
-                balls.pop_back();
-                ball_velocities.pop_back();
-                ball_trails.pop_back();
-            }
-            return;
-        }
-        case leftScore: {
-            left_score++;
-            return;
-        }
-        case rightScore: {
-            right_score++;
-            return;
-        }
-        case shrink: {
-            court_radius = glm::vec2(3.5f, 2.5f);
-            paddle_radius = glm::vec2(0.1f, 0.5f);
-            ball_radius = glm::vec2(0.1f, 0.1f);
-            left_paddle = glm::vec2(-3.25f, 0);
-            right_paddle = glm::vec2(3.25f, 0);
-            trail_length = 0.65f;
-            blocks.clear();
-            return;
-        }
-        case expand: {
-            court_radius = glm::vec2(7.0f, 5.0f);
-            paddle_radius = glm::vec2(0.2f, 1.0f);
-            ball_radius = glm::vec2(0.2f, 0.2f);
-            left_paddle = glm::vec2(-court_radius.x + 0.5f, 0.0f);
-            right_paddle = glm::vec2( court_radius.x - 0.5f, 0.0f);
-            trail_length = 1.3f;
-            blocks.clear();
-            return;
-        }
-        default: return;
-    }
+	std::vector< SnapshotScalars > scalars;
+	read_chunk(from, "scal", &scalars);
+	if (scalars.size() != 1) throw std::runtime_error("Snapshot has malformed 'scal' chunk.");
+
+	std::vector< glm::vec2 > new_balls;
+	std::vector< glm::vec2 > new_velocities;
+	read_chunk(from, "ball", &new_balls);
+	read_chunk(from, "bvel", &new_velocities);
+	if (new_balls.empty() || new_velocities.size() != new_balls.size()) {
+		throw std::runtime_error("Snapshot has mismatched ball/velocity counts.");
+	}
+
+	std::vector< uint32_t > trail_lengths;
+	std::vector< glm::vec3 > trail_points;
+	read_chunk(from, "tlen", &trail_lengths);
+	read_chunk(from, "tpts", &trail_points);
+	if (trail_lengths.size() != new_balls.size()) throw std::runtime_error("Snapshot has mismatched trail count.");
+	std::vector< std::deque< glm::vec3 > > new_trails;
+	new_trails.reserve(trail_lengths.size());
+	size_t offset = 0;
+	for (uint32_t length : trail_lengths) {
+		if (length > trail_points.size() - offset) throw std::runtime_error("Snapshot trail data is truncated.");
+		new_trails.emplace_back(trail_points.begin() + offset, trail_points.begin() + offset + length);
+		offset += length;
+	}
+
+	std::vector< SnapshotBlock > snapshot_blocks;
+	read_chunk(from, "blck", &snapshot_blocks);
+	std::vector< Block > new_blocks;
+	new_blocks.reserve(snapshot_blocks.size());
+	for (auto const &b : snapshot_blocks) {
+		if (b.type < regular || b.type > expand) throw std::runtime_error("Snapshot has unknown block type " + std::to_string(b.type) + ".");
+		new_blocks.emplace_back(b.pos, BLOCK_TYPE(b.type));
+	}
+
+	std::vector< char > mt_text;
+	read_chunk(from, "rng ", &mt_text);
+	std::istringstream mt_state(std::string(mt_text.begin(), mt_text.end()));
+	std::mt19937 new_mt;
+	if (!(mt_state >> new_mt)) throw std::runtime_error("Snapshot has malformed generator state.");
+
+	//everything parsed; commit:
+	SnapshotScalars const &s = scalars[0];
+	court_radius = s.court_radius;
+	paddle_radius = s.paddle_radius;
+	block_radius = s.block_radius;
+	ball_radius = s.ball_radius;
+	left_paddle = s.left_paddle;
+	right_paddle = s.right_paddle;
+	left_score = s.left_score;
+	right_score = s.right_score;
+	ai_offset = s.ai_offset;
+	ai_offset_update = s.ai_offset_update;
+	block_spawn = s.block_spawn;
+	block_update = s.block_update;
+	trail_length = s.trail_length;
+
+	scheduler.invalidate();
+	balls = std::move(new_balls);
+	ball_velocities = std::move(new_velocities);
+	ball_trails = std::move(new_trails);
+	blocks = std::move(new_blocks);
+	mt = new_mt;
 }
 
-glm::u8vec4 PongMode::get_color(Block &block) {
-    //some nice colors from the course web page:
-    #define HEX_TO_U8VEC4( HX ) (glm::u8vec4( (HX >> 24) & 0xff, (HX >> 16) & 0xff, (HX >> 8) & 0xff, (HX) & 0xff ))
-    switch(block.type) {
-        case split: return HEX_TO_U8VEC4(0xffff00ee);
-        case del: return HEX_TO_U8VEC4(0x000000ff);
-        case leftScore: return HEX_TO_U8VEC4(0x55ea46ee);
-        case rightScore: return HEX_TO_U8VEC4(0xdc143cee);
-        case shrink: return HEX_TO_U8VEC4(0x555555ff);
-        case expand: return HEX_TO_U8VEC4(0x5514eeee);
-        default: return HEX_TO_U8VEC4(0xf2d2b6ff);
-    }
-}
\ No newline at end of file
+glm::u8vec4 PongMode::get_color(Block const &block) const {
+	static constexpr uint32_t Colors[expand + 1] = {
+		BlockTraits< regular >::Color, //(unused)
+		BlockTraits< regular >::Color,
+		BlockTraits< split >::Color,
+		BlockTraits< del >::Color,
+		BlockTraits< leftScore >::Color,
+		BlockTraits< rightScore >::Color,
+		BlockTraits< shrink >::Color,
+		BlockTraits< expand >::Color,
+	};
+	uint32_t hx = Colors[block.type];
+	return glm::u8vec4((hx >> 24) & 0xff, (hx >> 16) & 0xff, (hx >> 8) & 0xff, hx & 0xff);
+}
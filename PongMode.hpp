@@ -1,4 +1,7 @@
-#include "ColorTextureProgram.hpp"
+#pragma once
+
+#include "Renderer.hpp"
+#include "BallScheduler.hpp"
 
 #include "Mode.hpp"
 #include "GL.hpp"
@@ -6,9 +9,13 @@
 #include <glm/glm.hpp>
 
 #include <iostream>
+#include <istream>
+#include <ostream>
 #include <vector>
 #include <list>
 #include <deque>
+#include <memory>
+#include <random>
 
 /**
  * Different types of blocks
@@ -33,11 +40,41 @@ public:
     Block(glm::vec2 pos, BLOCK_TYPE type): pos(pos), type(type) {}
 };
 
+struct PongMode;
+
+/**
+ * Compile-time description of each block type:
+ *  Name - counter name for hits (see Profiler::count)
+ *  Color - 0xRRGGBBAA
+ *  ClearsBlocks - applying the effect removes every block
+ *  apply(pong, count) - effect of 'count' hits in one step (defined in PongMode.cpp)
+ */
+template< BLOCK_TYPE Type >
+struct BlockTraits;
+
+#define BLOCK_TRAITS( TYPE, NAME, COLOR, CLEARS ) \
+	template< > struct BlockTraits< TYPE > { \
+		static constexpr char const *Name = NAME; \
+		static constexpr uint32_t Color = COLOR; \
+		static constexpr bool ClearsBlocks = CLEARS; \
+		static void apply(PongMode &pong, uint32_t count); \
+	}
+BLOCK_TRAITS(regular, "blocks.regular", 0xf2d2b6ff, false);
+BLOCK_TRAITS(split, "blocks.split", 0xffff00ee, false);
+BLOCK_TRAITS(del, "blocks.del", 0x000000ff, false);
+BLOCK_TRAITS(leftScore, "blocks.leftScore", 0x55ea46ee, false);
+BLOCK_TRAITS(rightScore, "blocks.rightScore", 0xdc143cee, false);
+BLOCK_TRAITS(shrink, "blocks.shrink", 0x555555ff, true);
+BLOCK_TRAITS(expand, "blocks.expand", 0x5514eeee, true);
+#undef BLOCK_TRAITS
+
 /*
  * PongMode is a game mode that implements a single-player game of Pong.
  */
 struct PongMode : Mode {
-	PongMode();
+	//'seed' initializes the random number generator (so replays are reproducible);
+	// the constructor makes no GL calls, so a game can be preloaded off the main thread:
+	PongMode(uint32_t seed, std::shared_ptr< Renderer > const &renderer);
 	virtual ~PongMode();
 
 	//functions called by main loop:
@@ -45,6 +82,15 @@ struct PongMode : Mode {
 	virtual void update(float elapsed) override;
 	virtual void draw(glm::uvec2 const &drawable_size) override;
 
+	//----- snapshots -----
+
+	//write/read the full game state as a versioned little-endian binary blob
+	// (read_write_chunk.hpp chunks, bulk-copied, so O(size) either way).
+	//NOTE: load_snapshot throws on error and leaves the state unchanged.
+	static constexpr uint32_t SnapshotVersion = 1;
+	void save_snapshot(std::ostream &to) const;
+	void load_snapshot(std::istream &from);
+
 	//----- game state -----
 
 	glm::vec2 court_radius = glm::vec2(7.0f, 5.0f);
@@ -68,6 +114,55 @@ struct PongMode : Mode {
     float block_spawn = 3.0f;
     float block_update = 0.0f;
 
+	std::mt19937 mt; //mersenne twister pseudo-random number generator
+
+	//----- collision -----
+
+	//the first thing a moving ball runs into:
+	struct Hit {
+		enum Kind : uint8_t {
+			None,
+			LeftPaddle, RightPaddle,
+			BlockHit, //blocks[block]
+			TopWall, BottomWall, LeftWall, RightWall,
+		} kind = None;
+		uint32_t block = 0;
+		float time = 1.0f; //fraction of the swept motion before contact
+		glm::vec2 normal = glm::vec2(0.0f); //points away from what was hit
+	};
+
+	//the earliest hit for a ball at 'at' moving by 'delta' (skipping whatever 'ignore' refers to):
+	// 'paddles' = false leaves out the paddles (they move, so BallScheduler handles them separately)
+	Hit sweep(glm::vec2 const &at, glm::vec2 const &delta, Hit const &ignore, bool paddles = true) const;
+
+	//move ball 'i' to the contact point of 'hit' and bounce it; marks blocks in blocks_hit.
+	// returns true if the ball bounced (for side walls: if a point was scored)
+	bool resolve(uint32_t i, Hit const &hit);
+
+	//apply the effects of every block in blocks_hit (bucketed by type) and remove those blocks:
+	// types apply in BLOCK_TYPE order, stopping after the first type that clears all blocks
+	void apply_block_hits();
+
+	//split blocks stop doubling the balls past this many:
+	static constexpr uint32_t MaxBalls = 1u << 20;
+
+	//ball speed cap (was 10 when collisions were discrete overlap tests, to stop tunneling):
+	float max_speed_multiplier = 40.0f;
+
+	//most collisions a ball resolves per step (leftover motion is dropped):
+	static constexpr uint32_t MaxBounces = 8;
+
+	//move ball 'i' by 'scale' * its velocity, colliding along the way; counts points scored.
+	// 'paddles' = false skips the paddles (for balls paddle_slab_candidates() ruled out)
+	void move_ball(uint32_t i, float scale, uint32_t *left_scored, uint32_t *right_scored, bool paddles = true);
+
+	//event-driven alternative to testing every ball every step (see BallScheduler.hpp):
+	bool event_driven = false;
+	BallScheduler scheduler;
+
+	std::vector< uint8_t > blocks_hit; //parallel to 'blocks' during update
+	std::vector< uint8_t > near_paddle; //parallel to 'balls' during update
+
 	//----- pretty gradient trails -----
 
 	float trail_length = 1.3f;
@@ -75,44 +170,45 @@ struct PongMode : Mode {
 
 	//----- opengl assets / helpers ------
 
-	//draw functions will work on vectors of vertices, defined as follows:
-	struct Vertex {
-		Vertex(glm::vec3 const &Position_, glm::u8vec4 const &Color_, glm::vec2 const &TexCoord_) :
-			Position(Position_), Color(Color_), TexCoord(TexCoord_) { }
-		glm::vec3 Position;
-		glm::u8vec4 Color;
-		glm::vec2 TexCoord;
-	};
-	static_assert(sizeof(Vertex) == 4*3 + 1*4 + 4*2, "PongMode::Vertex should be packed");
-
-	//Shader program that draws transformed, vertices tinted with vertex colors:
-	ColorTextureProgram color_texture_program;
+	//draw() submits to renderer (see Renderer.hpp) as one layer in court coordinates,
+	// using one of these vertex formats:
+	typedef Renderer::Vertex Vertex;
+	typedef Renderer::CompactVertex CompactVertex; //(the scene -- walls + padding + scores -- stays well inside +/- Extent)
 
-	//Buffer used to hold vertex data during drawing:
-	GLuint vertex_buffer = 0;
+	//draw with CompactVertex + color_program instead of Vertex + color_texture_program (F6 in main.cpp):
+	bool compact_vertices = false;
 
-	//Vertex Array Object that maps buffer locations to color_texture_program attribute locations:
-	GLuint vertex_buffer_for_color_texture_program = 0;
-
-	//Solid white texture:
-	GLuint white_tex = 0;
+	//Shared programs, buffers, and textures:
+	std::shared_ptr< Renderer > renderer;
 
 	//matrix that maps from clip coordinates to court-space coordinates:
 	glm::mat3x2 clip_to_court = glm::mat3x2(1.0f);
 	// computed in draw() as the inverse of OBJECT_TO_CLIP
 	// (stored here so that the mouse handling code can use it to position the paddle)
 
+	//----- mouse input -----
+
+	//motion events only note the newest position (a fast mouse sends several per frame);
+	// apply_mouse() maps it to left_paddle once per frame (main.cpp calls it before update):
+	bool mouse_pending = false;
+	glm::vec2 mouse_window = glm::vec2(0.0f); //window pixels, top-left origin
+	glm::uvec2 mouse_window_size = glm::uvec2(0); //window size as of the last event
+	void apply_mouse();
+
+	//with late_mouse, draw() re-reads the mouse (SDL_GetMouseState) just before building vertices,
+	// so the paddle is drawn -- and next updated -- where the mouse is now, not where it was when
+	// events were polled. Off by default; main.cpp turns it on except during replay playback:
+	bool late_mouse = false;
+	//SDL_GetPerformanceCounter() when draw() last re-read the mouse (0 = it didn't); main.cpp passes it to
+	// FramePacer::input_sampled, so input.latency measures from the position actually drawn:
+	uint64_t late_mouse_counter = 0;
+
+	//set left_paddle.y (clamped to the court) from a mouse position, using the last draw's clip_to_court:
+	void set_paddle_from_mouse(glm::vec2 const &window_px, glm::uvec2 const &window_size);
 
-    //----- Methods for handling block interactions -----
-    
-    /**
-     * Called if the block is destroyed, 
-     * perform the special block effect based on type 
-     */
-    void do_effect(Block &block);
 
     /**
      * Returns the color of this block depending on the type
      */
-    glm::u8vec4 get_color(Block &block);
+    glm::u8vec4 get_color(Block const &block) const;
 };
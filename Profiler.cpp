@@ -0,0 +1,175 @@
+#include "Profiler.hpp"
+
+#include "log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+Profiler profiler;
+
+uint64_t Profiler::now_ns() {
+	return uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(
+		std::chrono::steady_clock::now().time_since_epoch()
+	).count());
+}
+
+void Profiler::Ring::push(Sample const &sample) {
+	uint32_t h = head.load(std::memory_order_relaxed);
+	if (h - tail.load(std::memory_order_acquire) >= Size) {
+		//reader is behind; drop rather than block the instrumented code:
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	samples[h & (Size - 1)] = sample;
+	head.store(h + 1, std::memory_order_release);
+}
+
+Profiler::Ring &Profiler::ring() {
+	static thread_local Ring *thread_ring = nullptr;
+	if (!thread_ring) {
+		std::lock_guard< std::mutex > lock(rings_mutex);
+		rings.emplace_back(new Ring);
+		thread_ring = rings.back().get();
+		thread_ring->thread = uint32_t(rings.size() - 1);
+	}
+	return *thread_ring;
+}
+
+void Profiler::record(char const *name, uint64_t duration_ns) {
+	Ring &r = ring();
+	Sample sample;
+	sample.name = name;
+	sample.begin_ns = 0;
+	sample.end_ns = duration_ns;
+	sample.depth = 0;
+	sample.thread = r.thread;
+	sample.external = true;
+	r.push(sample);
+}
+
+void Profiler::count(char const *name, uint64_t n) {
+	Ring &r = ring();
+	Sample sample;
+	sample.name = name;
+	sample.end_ns = n;
+	sample.thread = r.thread;
+	sample.counter = true;
+	r.push(sample);
+}
+
+Profiler::Counter &Profiler::counter(char const *name) {
+	for (auto &c : counters) {
+		if (c.name == name || std::strcmp(c.name, name) == 0) return c;
+	}
+	counters.emplace_back();
+	counters.back().name = name;
+	return counters.back();
+}
+
+void Profiler::print_counters(std::ostream &out) const {
+	if (counters.empty()) return;
+	out << "Counters:";
+	for (auto const &c : counters) {
+		out << ' ' << c.name << '=' << c.total;
+	}
+	out << std::endl;
+}
+
+Profiler::Zone &Profiler::zone(char const *name, uint32_t depth) {
+	for (auto &z : zones) {
+		if (z.name == name || std::strcmp(z.name, name) == 0) return z;
+	}
+	zones.emplace_back();
+	zones.back().name = name;
+	zones.back().depth = depth;
+	return zones.back();
+}
+
+void Profiler::end_frame() {
+	uint64_t now = now_ns();
+	if (last_frame_ns == 0) last_frame_ns = now;
+
+	//"frame" is the wall-clock time between calls to end_frame:
+	zone("frame", 0).frame_ms = (now - last_frame_ns) / 1e6f;
+	last_frame_ns = now;
+
+	for (auto &c : counters) {
+		c.last = 0;
+	}
+
+	{ //drain every thread's ring into the per-zone accumulators:
+		std::lock_guard< std::mutex > lock(rings_mutex);
+		for (auto &r : rings) {
+			uint32_t t = r->tail.load(std::memory_order_relaxed);
+			uint32_t h = r->head.load(std::memory_order_acquire);
+			for (; t != h; ++t) {
+				Sample const &s = r->samples[t & (Ring::Size - 1)];
+				if (s.counter) {
+					Counter &c = counter(s.name);
+					c.last += s.end_ns;
+					c.total += s.end_ns;
+					continue;
+				}
+				zone(s.name, s.depth + 1).frame_ms += (s.end_ns - s.begin_ns) / 1e6f;
+				if (trace && !s.external) {
+					trace_events.emplace_back(TraceWriter::Event{s.name, s.begin_ns, s.thread, s.depth, true});
+					trace_events.emplace_back(TraceWriter::Event{s.name, s.end_ns, s.thread, s.depth, false});
+				}
+			}
+			r->tail.store(h, std::memory_order_release);
+		}
+	}
+	if (trace) trace->submit(trace_events);
+
+	//update rolling statistics:
+	static std::vector< float > sorted; //scratch space, reused between frames
+	for (uint32_t i = 0; i < zones.size(); ++i) {
+		Zone &z = zones[i];
+		z.last_ms = z.frame_ms;
+		if (z.history.size() < Window) {
+			z.history.emplace_back(z.frame_ms);
+		} else {
+			z.history[z.next] = z.frame_ms;
+			z.next = (z.next + 1) % Window;
+		}
+
+		sorted.assign(z.history.begin(), z.history.end());
+		std::sort(sorted.begin(), sorted.end());
+		float sum = 0.0f;
+		for (float ms : sorted) sum += ms;
+		z.min_ms = sorted.front();
+		z.avg_ms = sum / sorted.size();
+		uint32_t p99 = uint32_t(std::ceil(0.99f * sorted.size()));
+		z.p99_ms = sorted[std::max(p99, 1U) - 1];
+
+		if (keep_csv) {
+			csv_rows.emplace_back(CSVRow{frame, i, z.frame_ms});
+		}
+		z.frame_ms = 0.0f;
+	}
+
+	++frame;
+}
+
+void Profiler::write_csv(std::string const &filename) const {
+	std::ofstream out(filename);
+	if (!out) {
+		LOG_ERROR("Failed to open '" << filename << "' for writing profile.");
+		return;
+	}
+	out << "frame,zone,depth,ms\n";
+	for (auto const &row : csv_rows) {
+		Zone const &z = zones[row.zone];
+		out << row.frame << ',' << z.name << ',' << z.depth << ',' << row.ms << '\n';
+	}
+	uint32_t dropped = 0;
+	for (auto const &r : rings) {
+		dropped += r->dropped.load(std::memory_order_relaxed);
+	}
+	LOG_INFO("Wrote " << csv_rows.size() << " profile rows to '" << filename << "'"
+		<< (dropped ? " (" + std::to_string(dropped) + " samples dropped)" : std::string()) << ".");
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "TraceWriter.hpp"
+
+/*
+ * Profiler is a lightweight hierarchical frame profiler.
+ *
+ * Instrument code with PROFILE_ZONE("name"), which times the enclosing scope.
+ * Every thread records its zones into its own fixed-size ring buffer
+ *  (single writer, single reader, no locks on the recording path).
+ * Once per frame the main loop calls end_frame(), which drains the rings
+ *  and keeps a rolling window of per-zone frame times (min/avg/p99).
+ *
+ * Event counts go through the same rings with count("name", n) -- a cheap
+ *  replacement for printing from hot code; totals are kept per name.
+ *
+ * NOTE: zone names must be string literals -- only the pointer is stored.
+ */
+
+struct Profiler {
+	//nanoseconds on a steady clock (arbitrary epoch):
+	static uint64_t now_ns();
+
+	//one recorded zone:
+	struct Sample {
+		char const *name = nullptr;
+		uint64_t begin_ns = 0;
+		uint64_t end_ns = 0;
+		uint32_t depth = 0; //nesting depth within the recording thread
+		uint32_t thread = 0; //index of the recording thread
+		bool external = false; //duration added with record(); begin_ns/end_ns aren't on the CPU timeline
+		bool counter = false; //added with count(); end_ns holds the count
+	};
+
+	//per-thread ring buffer of samples:
+	// written only by the owning thread, read only by the thread calling end_frame()
+	struct Ring {
+		static constexpr uint32_t Size = 4096; //must be a power of two
+		std::array< Sample, Size > samples;
+		std::atomic< uint32_t > head{0}; //next slot to write
+		std::atomic< uint32_t > tail{0}; //next slot to read
+		std::atomic< uint32_t > dropped{0}; //samples lost because the ring was full
+		uint32_t depth = 0; //current nesting depth (owning thread only)
+		uint32_t thread = 0;
+
+		void push(Sample const &sample);
+	};
+
+	//rolling statistics for one zone:
+	struct Zone {
+		char const *name = nullptr;
+		uint32_t depth = 0;
+		std::vector< float > history; //per-frame total time in milliseconds (circular, up to Window entries)
+		uint32_t next = 0; //next slot of history to overwrite once it is full
+		float frame_ms = 0.0f; //accumulator for the frame in progress
+		float last_ms = 0.0f;
+		float min_ms = 0.0f;
+		float avg_ms = 0.0f;
+		float p99_ms = 0.0f;
+	};
+
+	//number of frames kept for min/avg/p99:
+	static constexpr uint32_t Window = 120;
+
+	//call once per frame (after the swap) to drain samples and update statistics:
+	void end_frame();
+
+	//add a duration measured some other way (e.g., GPU timer queries) as a top-level zone:
+	void record(char const *name, uint64_t duration_ns);
+
+	//add 'n' to the counter 'name':
+	void count(char const *name, uint64_t n = 1);
+
+	struct Counter {
+		char const *name = nullptr;
+		uint64_t last = 0; //total over the last finished frame
+		uint64_t total = 0; //total since startup
+	};
+	//counters in order of first appearance (updated by end_frame):
+	std::vector< Counter > counters;
+	void print_counters(std::ostream &out) const;
+
+	//zones in order of first appearance ("frame" -- the full frame time -- is always first):
+	std::vector< Zone > zones;
+	uint32_t frame = 0;
+
+	//draw the min/avg/p99 overlay (ProfilerOverlayMode, toggled from main):
+	bool show_overlay = false;
+
+	//if set, every zone is also sent to this trace as begin/end events:
+	TraceWriter *trace = nullptr;
+
+	//keep per-frame zone times so they can be written out with write_csv():
+	bool keep_csv = false;
+	void write_csv(std::string const &filename) const;
+
+	//returns the ring for the calling thread (created on first use):
+	Ring &ring();
+
+	//---- internals ----
+	Zone &zone(char const *name, uint32_t depth);
+	Counter &counter(char const *name);
+	uint64_t last_frame_ns = 0;
+
+	struct CSVRow {
+		uint32_t frame;
+		uint32_t zone;
+		float ms;
+	};
+	std::vector< CSVRow > csv_rows;
+	std::vector< TraceWriter::Event > trace_events;
+
+	std::mutex rings_mutex; //guards 'rings' (only locked when a thread records its first sample or when draining)
+	std::vector< std::unique_ptr< Ring > > rings;
+};
+
+extern Profiler profiler;
+
+//times the enclosing scope:
+struct ProfileZone {
+	ProfileZone(char const *name_) : name(name_), ring(profiler.ring()) {
+		depth = ring.depth++;
+		begin_ns = Profiler::now_ns();
+	}
+	~ProfileZone() {
+		end();
+	}
+	//end the zone before the end of the scope (for timing consecutive phases of one function):
+	void end() {
+		if (ended) return;
+		ended = true;
+		Profiler::Sample sample;
+		sample.name = name;
+		sample.begin_ns = begin_ns;
+		sample.end_ns = Profiler::now_ns();
+		sample.depth = depth;
+		sample.thread = ring.thread;
+		ring.push(sample);
+		--ring.depth;
+	}
+	ProfileZone(ProfileZone const &) = delete;
+	ProfileZone &operator=(ProfileZone const &) = delete;
+
+	char const *name;
+	Profiler::Ring &ring;
+	uint32_t depth = 0;
+	uint64_t begin_ns = 0;
+	bool ended = false;
+};
+
+#define PROFILE_ZONE_CAT2(A, B) A ## B
+#define PROFILE_ZONE_CAT(A, B) PROFILE_ZONE_CAT2(A, B)
+#define PROFILE_ZONE(NAME) ProfileZone PROFILE_ZONE_CAT(profile_zone_, __LINE__)(NAME)
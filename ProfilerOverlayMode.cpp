@@ -0,0 +1,53 @@
+#include "ProfilerOverlayMode.hpp"
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+ProfilerOverlayMode::ProfilerOverlayMode(std::shared_ptr< Renderer > const &renderer_) : renderer(renderer_) {
+	assert(renderer && "ProfilerOverlayMode draws with a shared Renderer");
+}
+
+void ProfilerOverlayMode::draw(glm::uvec2 const &drawable_size) {
+	//drawn in pixels, lower-left origin:
+	glm::vec2 size = glm::vec2(drawable_size);
+	glm::mat4 pixels_to_clip = glm::mat4(
+		glm::vec4(2.0f / size.x, 0.0f, 0.0f, 0.0f),
+		glm::vec4(0.0f, 2.0f / size.y, 0.0f, 0.0f),
+		glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+		glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f)
+	);
+	Renderer::Layer layer = renderer->layer(pixels_to_clip);
+
+	const float frame_ms = 1000.0f / 60.0f;
+	const float ms_to_px = size.x / (2.0f * frame_ms);
+	const float row_radius = std::min(0.02f * size.y, 0.5f * size.y / std::max< size_t >(profiler.zones.size(), 1));
+	const float tick_radius = 1.0f;
+	const glm::u8vec4 overlay_bg = glm::u8vec4(0x00, 0x00, 0x00, 0x88);
+	const glm::u8vec4 avg_color = glm::u8vec4(0x55, 0xea, 0x46, 0xcc);
+	const glm::u8vec4 min_color = glm::u8vec4(0xff, 0xff, 0xff, 0xff);
+	const glm::u8vec4 p99_color = glm::u8vec4(0xdc, 0x14, 0x3c, 0xff);
+	const glm::u8vec4 frame_color = glm::u8vec4(0xff, 0xff, 0xff, 0x88);
+	auto ms_to_x = [&](float ms) {
+		return std::min(ms * ms_to_px, size.x);
+	};
+
+	//(rects are one batch and so draw in order: each row's background, then its bar and ticks)
+	for (uint32_t i = 0; i < profiler.zones.size(); ++i) {
+		Profiler::Zone const &z = profiler.zones[i];
+		float y = size.y - (2.0f * i + 1.0f) * row_radius;
+		renderer->rect(layer, glm::vec2(0.5f * size.x, y), glm::vec2(0.5f * size.x, row_radius), overlay_bg);
+		//average as a bar, indented slightly by depth so nesting is visible:
+		float x1 = ms_to_x(z.avg_ms);
+		float inset = 0.1f * row_radius * std::min(z.depth, 4U);
+		renderer->rect(layer, glm::vec2(0.5f * x1, y), glm::vec2(0.5f * x1, row_radius - 0.1f * row_radius - inset), avg_color);
+		//min and p99 as ticks:
+		renderer->rect(layer, glm::vec2(ms_to_x(z.min_ms), y), glm::vec2(tick_radius, row_radius), min_color);
+		renderer->rect(layer, glm::vec2(ms_to_x(z.p99_ms), y), glm::vec2(tick_radius, row_radius), p99_color);
+	}
+
+	//one 60Hz frame, down the rows:
+	float x = ms_to_x(frame_ms) + 0.5f; //(pixel center)
+	renderer->line(layer, glm::vec2(x, size.y), glm::vec2(x, size.y - 2.0f * row_radius * profiler.zones.size()), frame_color);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Mode.hpp"
+#include "Renderer.hpp"
+
+#include <memory>
+
+/*
+ * ProfilerOverlayMode draws the profiler's per-zone timings (see Profiler.hpp)
+ *  over whatever is under it on the mode stack; push it as an overlay.
+ *
+ * One row per zone (in profiler.zones order, top to bottom): average as a bar,
+ *  minimum as a white tick, 99th percentile as a red tick. The window width is
+ *  two 60Hz frames, with a line at one frame.
+ */
+struct ProfilerOverlayMode : Mode {
+	ProfilerOverlayMode(std::shared_ptr< Renderer > const &renderer);
+
+	virtual void draw(glm::uvec2 const &drawable_size) override;
+
+	std::shared_ptr< Renderer > renderer;
+};
@@ -0,0 +1,505 @@
+#include "Renderer.hpp"
+
+#include "gl_caps.hpp"
+#include "gl_errors.hpp"
+#include "gl_state.hpp"
+#include "Profiler.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+constexpr uint32_t Renderer::QuadIndexQuads;
+constexpr uint32_t Renderer::StreamFrames;
+constexpr size_t Renderer::StreamRegionMinimum;
+
+Renderer::Renderer() {
+	{ //solid white texture:
+		//ask OpenGL to fill white_tex with the name of an unused texture object:
+		glGenTextures(1, &white_tex);
+
+		//bind that texture object as a GL_TEXTURE_2D-type texture:
+		glBindTexture(GL_TEXTURE_2D, white_tex);
+
+		//upload a 1x1 image of solid white to the texture:
+		glm::uvec2 size = glm::uvec2(1,1);
+		std::vector< glm::u8vec4 > data(size.x*size.y, glm::u8vec4(0xff, 0xff, 0xff, 0xff));
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+
+		//set filtering and wrapping parameters:
+		//(it's a bit silly to mipmap a 1x1 texture, but I'm doing it because you may want to use this code to load different sizes of texture)
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		//since texture uses a mipmap and we haven't uploaded one, instruct opengl to make one for us:
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		//Okay, texture uploaded, can unbind it:
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
+	}
+
+	{ //quad index buffer:
+		std::vector< uint16_t > indices;
+		indices.reserve(6 * QuadIndexQuads);
+		for (uint32_t q = 0; q < QuadIndexQuads; ++q) {
+			uint16_t v = uint16_t(4 * q);
+			indices.insert(indices.end(), { v, uint16_t(v+1), uint16_t(v+2), v, uint16_t(v+2), uint16_t(v+3) });
+		}
+		glGenBuffers(1, &quad_index_buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_index_buffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(indices[0]), indices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
+	}
+
+	{ //vertex buffer, and the vertex array objects that read it:
+		//ask OpenGL for the names of two unused vertex array objects:
+		glGenVertexArrays(1, &vertex_buffer_for_color_texture_program);
+		glGenVertexArrays(1, &vertex_buffer_for_color_program);
+
+		if (gl_caps.persistent_mapping) {
+			allocate_stream(0); //(also points the vertex arrays at it)
+		} else {
+			glGenBuffers(1, &vertex_buffer);
+			//for now, buffer will be un-filled.
+			point_vertex_arrays();
+		}
+
+		if (gl_caps.indirect_draw) {
+			glGenBuffers(1, &indirect_buffer);
+		}
+
+		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
+	}
+
+	//(the setup above changed bindings behind the cache's back)
+	gl_state.invalidate();
+}
+
+void Renderer::point_vertex_arrays() {
+	{ //vertex array mapping buffer for color_texture_program:
+		//set vertex_buffer_for_color_texture_program as the current vertex array object:
+		glBindVertexArray(vertex_buffer_for_color_texture_program);
+
+		//set vertex_buffer as the source of glVertexAttribPointer() commands:
+		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+
+		//set up the vertex array object to describe arrays of Renderer::Vertex:
+		glVertexAttribPointer(
+			color_texture_program.Position_vec4, //attribute
+			3, //size
+			GL_FLOAT, //type
+			GL_FALSE, //normalized
+			sizeof(Vertex), //stride
+			(GLbyte *)0 + 0 //offset
+		);
+		glEnableVertexAttribArray(color_texture_program.Position_vec4);
+		//[Note that it is okay to bind a vec3 input to a vec4 attribute -- the w component will be filled with 1.0 automatically]
+
+		glVertexAttribPointer(
+			color_texture_program.Color_vec4, //attribute
+			4, //size
+			GL_UNSIGNED_BYTE, //type
+			GL_TRUE, //normalized
+			sizeof(Vertex), //stride
+			(GLbyte *)0 + 4*3 //offset
+		);
+		glEnableVertexAttribArray(color_texture_program.Color_vec4);
+
+		glVertexAttribPointer(
+			color_texture_program.TexCoord_vec2, //attribute
+			2, //size
+			GL_FLOAT, //type
+			GL_FALSE, //normalized
+			sizeof(Vertex), //stride
+			(GLbyte *)0 + 4*3 + 4*1 //offset
+		);
+		glEnableVertexAttribArray(color_texture_program.TexCoord_vec2);
+
+		//done referring to vertex_buffer, so unbind it:
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		//indices come from quad_index_buffer:
+		//(the element array binding is part of the vertex array object, so it stays bound)
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_index_buffer);
+
+		//done setting up vertex array object, so unbind it:
+		glBindVertexArray(0);
+
+		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
+	}
+
+	{ //vertex array mapping the same buffer, as CompactVertex, for color_program:
+		glBindVertexArray(vertex_buffer_for_color_program);
+		glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+
+		//positions are passed as plain (not normalized) integers; flush() folds the
+		// 1 / CompactVertex::Scale back into OBJECT_TO_CLIP:
+		glVertexAttribPointer(
+			color_program.Position_vec4, //attribute
+			2, //size
+			GL_SHORT, //type
+			GL_FALSE, //normalized
+			sizeof(CompactVertex), //stride
+			(GLbyte *)0 + 0 //offset
+		);
+		glEnableVertexAttribArray(color_program.Position_vec4);
+
+		glVertexAttribPointer(
+			color_program.Color_vec4, //attribute
+			4, //size
+			GL_UNSIGNED_BYTE, //type
+			GL_TRUE, //normalized
+			sizeof(CompactVertex), //stride
+			(GLbyte *)0 + 2*2 //offset
+		);
+		glEnableVertexAttribArray(color_program.Color_vec4);
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quad_index_buffer);
+		glBindVertexArray(0);
+
+		GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
+	}
+}
+
+Renderer::~Renderer() {
+	//(deleting bound objects unbinds them, and their names may be reused)
+	gl_state.invalidate();
+
+	glDeleteVertexArrays(1, &vertex_buffer_for_color_program);
+	vertex_buffer_for_color_program = 0;
+
+	glDeleteVertexArrays(1, &vertex_buffer_for_color_texture_program);
+	vertex_buffer_for_color_texture_program = 0;
+
+	glDeleteBuffers(1, &indirect_buffer);
+	indirect_buffer = 0;
+
+	for (GLsync &fence : stream_fences) {
+		if (fence) glDeleteSync(fence);
+		fence = nullptr;
+	}
+	//(deleting a mapped buffer unmaps it)
+	glDeleteBuffers(1, &vertex_buffer);
+	vertex_buffer = 0;
+	stream_mapped = nullptr;
+
+	glDeleteBuffers(1, &quad_index_buffer);
+	quad_index_buffer = 0;
+
+	glDeleteTextures(1, &white_tex);
+	white_tex = 0;
+}
+
+void Renderer::allocate_stream(size_t region_bytes) {
+	size_t size = StreamRegionMinimum;
+	while (size < region_bytes) size *= 2;
+
+	//drop the old ring:
+	//(the GL keeps a deleted buffer's storage until the draws already issued from it are done)
+	for (GLsync &fence : stream_fences) {
+		if (fence) glDeleteSync(fence);
+		fence = nullptr;
+	}
+	if (vertex_buffer) glDeleteBuffers(1, &vertex_buffer);
+
+	//immutable storage, mapped once for good; coherent, so writes need no explicit flush:
+	GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glGenBuffers(1, &vertex_buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+	glBufferStorage(GL_ARRAY_BUFFER, StreamFrames * size, nullptr, flags);
+	stream_mapped = reinterpret_cast< uint8_t * >(glMapBufferRange(GL_ARRAY_BUFFER, 0, StreamFrames * size, flags));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if (!stream_mapped) {
+		throw std::runtime_error("Failed to map the renderer's vertex stream buffer.");
+	}
+	stream_region_bytes = size;
+	stream_region = 0;
+
+	point_vertex_arrays();
+
+	//(bindings changed behind the cache's back)
+	gl_state.invalidate();
+
+	GL_ERRORS(); //PARANOIA: print out any OpenGL errors that may have happened
+}
+
+uint8_t *Renderer::stream_begin(size_t bytes) {
+	if (bytes > stream_region_bytes) {
+		allocate_stream(bytes);
+	}
+	GLsync &fence = stream_fences[stream_region];
+	if (fence) {
+		//(the region was last drawn from StreamFrames frames ago, so this rarely has to wait)
+		if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+			profiler.count("draw.stream_waits");
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) { }
+		}
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+	return stream_mapped + stream_region * stream_region_bytes;
+}
+
+//----- per-frame drawing -----
+
+void Renderer::begin_frame() {
+	//read back any GPU pass timings that have finished:
+	gpu_timer.new_frame();
+}
+
+void Renderer::clear(glm::u8vec4 const &color) {
+	gpu_timer.begin("gpu.clear");
+	gl_state.clear_color(color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+	gpu_timer.end();
+}
+
+Renderer::Layer Renderer::layer(glm::mat4 const &object_to_clip) {
+	layers.emplace_back(object_to_clip);
+	return Layer(layers.size() - 1);
+}
+
+Renderer::Batch &Renderer::batch(Layer layer, Format format, Primitive primitive, GLuint texture) {
+	assert(layer < layers.size() && "layer() must be called (this frame) before submitting to a layer");
+	if (texture == 0) texture = white_tex;
+	//(modes submit to the batch they used last, so search from the most recent:)
+	for (uint32_t b = batch_count; b > 0; --b) {
+		Batch &batch = batches[b-1];
+		if (batch.layer == layer && batch.format == format && batch.primitive == primitive && batch.texture == texture) {
+			return batch;
+		}
+	}
+	if (batch_count == batches.size()) batches.emplace_back();
+	Batch &batch = batches[batch_count++];
+	batch.layer = layer;
+	batch.format = format;
+	batch.primitive = primitive;
+	batch.texture = texture;
+	assert(batch.vertices.empty() && batch.compact.empty());
+	return batch;
+}
+
+std::vector< Renderer::Vertex > &Renderer::quads(Layer layer, GLuint texture) {
+	return batch(layer, Full, Quads, texture).vertices;
+}
+
+std::vector< Renderer::CompactVertex > &Renderer::compact_quads(Layer layer) {
+	return batch(layer, Compact, Quads, 0).compact;
+}
+
+void Renderer::rect(Layer layer, glm::vec2 const &center, glm::vec2 const &radius, glm::u8vec4 const &color) {
+	std::vector< Vertex > &vertices = quads(layer);
+	vertices.emplace_back(glm::vec2(center.x-radius.x, center.y-radius.y), color);
+	vertices.emplace_back(glm::vec2(center.x+radius.x, center.y-radius.y), color);
+	vertices.emplace_back(glm::vec2(center.x+radius.x, center.y+radius.y), color);
+	vertices.emplace_back(glm::vec2(center.x-radius.x, center.y+radius.y), color);
+}
+
+void Renderer::textured_rect(Layer layer, glm::vec2 const &center, glm::vec2 const &radius, GLuint texture,
+	glm::vec2 const &tex_min, glm::vec2 const &tex_max, glm::u8vec4 const &color) {
+	std::vector< Vertex > &vertices = quads(layer, texture);
+	vertices.emplace_back(glm::vec3(center.x-radius.x, center.y-radius.y, 0.0f), color, glm::vec2(tex_min.x, tex_min.y));
+	vertices.emplace_back(glm::vec3(center.x+radius.x, center.y-radius.y, 0.0f), color, glm::vec2(tex_max.x, tex_min.y));
+	vertices.emplace_back(glm::vec3(center.x+radius.x, center.y+radius.y, 0.0f), color, glm::vec2(tex_max.x, tex_max.y));
+	vertices.emplace_back(glm::vec3(center.x-radius.x, center.y+radius.y, 0.0f), color, glm::vec2(tex_min.x, tex_max.y));
+}
+
+void Renderer::line(Layer layer, glm::vec2 const &a, glm::vec2 const &b, glm::u8vec4 const &color) {
+	std::vector< Vertex > &vertices = batch(layer, Full, Lines, 0).vertices;
+	vertices.emplace_back(a, color);
+	vertices.emplace_back(b, color);
+}
+
+void Renderer::flush() {
+	//---- order batches: by layer, then by state ----
+	order.clear();
+	for (uint32_t b = 0; b < batch_count; ++b) {
+		if (batches[b].vertices.empty() && batches[b].compact.empty()) continue;
+		order.emplace_back(b);
+	}
+	//(a layer has at most one batch per state, so there are no ties)
+	std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+		Batch const &A = batches[a];
+		Batch const &B = batches[b];
+		if (A.layer != B.layer) return A.layer < B.layer;
+		if (A.format != B.format) return A.format < B.format;
+		if (A.primitive != B.primitive) return A.primitive < B.primitive;
+		return A.texture < B.texture;
+	});
+
+	//---- upload: all Vertex data, then all CompactVertex data, in one buffer ----
+	//(Vertex data is a multiple of 24 bytes, so the CompactVertex data starts on a CompactVertex boundary)
+	size_t full_bytes = 0, compact_bytes = 0;
+	for (uint32_t b : order) {
+		Batch &batch = batches[b];
+		if (batch.format == Full) {
+			batch.first = uint32_t(full_bytes / sizeof(Vertex));
+			full_bytes += batch.vertices.size() * sizeof(Vertex);
+		} else {
+			batch.first = uint32_t(compact_bytes / sizeof(CompactVertex));
+			compact_bytes += batch.compact.size() * sizeof(CompactVertex);
+		}
+	}
+	//(where this frame's data starts in vertex_buffer, in bytes; only the ring starts anywhere but 0)
+	size_t frame_offset = 0;
+
+	if (!order.empty()) {
+		ProfileZone upload_zone("draw.upload");
+		gpu_timer.begin("gpu.upload");
+		if (gl_caps.persistent_mapping) {
+			//(straight into the mapped ring -- no GL calls at all, unless the ring must wait or grow)
+			uint8_t *to = stream_begin(full_bytes + compact_bytes);
+			frame_offset = stream_region * stream_region_bytes;
+			for (uint32_t b : order) {
+				Batch const &batch = batches[b];
+				if (batch.format == Full) {
+					std::memcpy(to + batch.first * sizeof(Vertex), batch.vertices.data(), batch.vertices.size() * sizeof(Vertex));
+				} else {
+					std::memcpy(to + full_bytes + batch.first * sizeof(CompactVertex), batch.compact.data(), batch.compact.size() * sizeof(CompactVertex));
+				}
+			}
+		} else {
+			gl_state.bind_buffer(GL_ARRAY_BUFFER, vertex_buffer); //set vertex_buffer as current
+			if (order.size() == 1) {
+				//(usual case: one batch, uploaded straight from its array)
+				Batch const &batch = batches[order[0]];
+				if (batch.format == Full) glBufferData(GL_ARRAY_BUFFER, full_bytes, batch.vertices.data(), GL_STREAM_DRAW);
+				else glBufferData(GL_ARRAY_BUFFER, compact_bytes, batch.compact.data(), GL_STREAM_DRAW);
+			} else {
+				glBufferData(GL_ARRAY_BUFFER, full_bytes + compact_bytes, nullptr, GL_STREAM_DRAW); //(fresh storage)
+				for (uint32_t b : order) {
+					Batch const &batch = batches[b];
+					if (batch.format == Full) {
+						glBufferSubData(GL_ARRAY_BUFFER, batch.first * sizeof(Vertex), batch.vertices.size() * sizeof(Vertex), batch.vertices.data());
+					} else {
+						glBufferSubData(GL_ARRAY_BUFFER, full_bytes + batch.first * sizeof(CompactVertex), batch.compact.size() * sizeof(CompactVertex), batch.compact.data());
+					}
+				}
+			}
+		}
+		gpu_timer.end();
+		upload_zone.end();
+	}
+	//first vertex of this frame's data, in each format:
+	//(ring regions are multiples of sizeof(Vertex) apart, so both divisions are exact)
+	uint32_t const full_base = uint32_t(frame_offset / sizeof(Vertex));
+	uint32_t const compact_base = uint32_t((frame_offset + full_bytes) / sizeof(CompactVertex));
+
+	//---- indirect draw commands: quad batches too big for one draw, in QuadIndexQuads pieces ----
+	//(a batch that fits in one piece is cheaper as a plain draw than as a command upload plus a multi-draw)
+	if (gl_caps.indirect_draw && !order.empty()) {
+		commands.clear();
+		for (uint32_t b : order) {
+			Batch &batch = batches[b];
+			batch.command_first = uint32_t(commands.size());
+			uint32_t quads = uint32_t((batch.format == Full ? batch.vertices.size() : batch.compact.size()) / 4);
+			if (batch.primitive == Quads && quads > QuadIndexQuads) {
+				uint32_t base = (batch.format == Full ? full_base : compact_base) + batch.first;
+				for (uint32_t first = 0; first < quads; first += QuadIndexQuads) {
+					DrawElementsIndirectCommand command;
+					command.count = 6 * std::min(quads - first, QuadIndexQuads);
+					command.instance_count = 1;
+					command.first_index = 0;
+					command.base_vertex = int32_t(base + 4 * first);
+					command.base_instance = 0; //(must be zero without ARB_base_instance)
+					commands.emplace_back(command);
+				}
+			}
+			batch.command_count = uint32_t(commands.size()) - batch.command_first;
+		}
+		if (!commands.empty()) {
+			//(the indirect buffer binding isn't vertex array state, so it stays put for the draws below)
+			gl_state.bind_buffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer);
+			glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data(), GL_STREAM_DRAW);
+		}
+	}
+	profiler.count("draw.upload_bytes", full_bytes + compact_bytes);
+	profiler.count("draw.batches", order.size());
+
+	//---- draw ----
+	//(through gl_state, so settings and bindings that are already in place -- usually all of them,
+	// since nothing is unbound afterward -- cost nothing)
+	if (!order.empty()) {
+		//use alpha blending:
+		gl_state.enable(GL_BLEND);
+		gl_state.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		//don't use the depth test:
+		gl_state.disable(GL_DEPTH_TEST);
+
+		gpu_timer.begin("gpu.draw");
+		Layer uniform_layer = Layer(-1);
+		int32_t uniform_format = -1;
+		for (uint32_t b : order) {
+			Batch const &batch = batches[b];
+			if (batch.format == Compact) {
+				gl_state.use_program(color_program.program);
+				gl_state.bind_vertex_array(vertex_buffer_for_color_program);
+			} else {
+				gl_state.use_program(color_texture_program.program);
+				gl_state.bind_vertex_array(vertex_buffer_for_color_texture_program);
+				gl_state.active_texture(GL_TEXTURE0);
+				gl_state.bind_texture(GL_TEXTURE_2D, batch.texture);
+			}
+			//the transform changes with the layer (or program):
+			if (batch.format != uniform_format || batch.layer != uniform_layer) {
+				if (batch.format == Compact) {
+					//compact positions are layer coordinates times CompactVertex::Scale:
+					glm::mat4 compact_to_clip = layers[batch.layer] * glm::mat4(
+						glm::vec4(1.0f / CompactVertex::Scale, 0.0f, 0.0f, 0.0f),
+						glm::vec4(0.0f, 1.0f / CompactVertex::Scale, 0.0f, 0.0f),
+						glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+						glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)
+					);
+					glUniformMatrix4fv(color_program.OBJECT_TO_CLIP_mat4, 1, GL_FALSE, glm::value_ptr(compact_to_clip));
+				} else {
+					glUniformMatrix4fv(color_texture_program.OBJECT_TO_CLIP_mat4, 1, GL_FALSE, glm::value_ptr(layers[batch.layer]));
+				}
+				uniform_format = batch.format;
+				uniform_layer = batch.layer;
+			}
+
+			if (batch.primitive == Lines) {
+				glDrawArrays(GL_LINES, GLint(full_base + batch.first), GLsizei(batch.vertices.size()));
+				continue;
+			}
+			//quads, through the index buffer; past QuadIndexQuads, in pieces (one multi-draw, if there are commands):
+			if (batch.command_count) {
+				glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT,
+					(GLbyte *)0 + batch.command_first * sizeof(DrawElementsIndirectCommand), GLsizei(batch.command_count), 0);
+				continue;
+			}
+			uint32_t base = (batch.format == Full ? full_base : compact_base) + batch.first;
+			uint32_t quads = uint32_t((batch.format == Full ? batch.vertices.size() : batch.compact.size()) / 4);
+			for (uint32_t first = 0; first < quads; first += QuadIndexQuads) {
+				glDrawElementsBaseVertex(GL_TRIANGLES, GLsizei(6 * std::min(quads - first, QuadIndexQuads)), GL_UNSIGNED_SHORT, (GLbyte *)0, GLint(base + 4 * first));
+			}
+		}
+		gpu_timer.end();
+
+		//the GPU is done with this ring region once it passes here:
+		if (gl_caps.persistent_mapping) {
+			stream_fences[stream_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			stream_region = (stream_region + 1) % StreamFrames;
+		}
+	}
+	gl_state.report_frame();
+
+	//---- reset for the next frame (keeping batch storage) ----
+	for (uint32_t b = 0; b < batch_count; ++b) {
+		batches[b].vertices.clear();
+		batches[b].compact.clear();
+	}
+	batch_count = 0;
+	layers.clear();
+
+	GL_ERRORS(); //PARANOIA: print errors just in case we did something wrong.
+}
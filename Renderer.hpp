@@ -0,0 +1,190 @@
+#pragma once
+
+#include "ColorTextureProgram.hpp"
+#include "ColorProgram.hpp"
+#include "GPUTimer.hpp"
+#include "GL.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/*
+ * Renderer owns the GL objects modes draw with -- shader programs, the solid
+ *  white texture, the quad index buffer, and one streamed vertex buffer -- and
+ *  a batched 2D drawing API on top of them:
+ *
+ * Each frame, a mode asks for a layer (with the transform its coordinates
+ *  need) and submits rectangles, textured rectangles, and lines to it. Nothing
+ *  is drawn until flush(), which uploads every batch in one buffer and draws
+ *  them layer by layer, sorted by state (vertex format, primitive, texture)
+ *  within a layer, so each state change happens once per layer per frame.
+ *
+ * Layers draw in the order they were made (Mode::stack_draw makes overlays
+ *  ask last). Within a layer, things with the same state draw in submission
+ *  order; things with different state may not -- use separate layers where
+ *  that order matters.
+ *
+ * Where the driver allows (see gl_caps.hpp), flush() writes vertices straight
+ *  into a persistently mapped ring buffer and draws each batch whose quads need
+ *  more than one index-buffer piece with one indirect multi-draw; otherwise it
+ *  uses plain core 3.3 uploads and draws.
+ *
+ * main.cpp calls begin_frame() before drawing the modes and flush() after.
+ * Create one after the GL context exists and share it by shared_ptr; it must
+ *  outlive every mode that uses it.
+ */
+
+struct Renderer {
+	Renderer();
+	~Renderer();
+	Renderer(Renderer const &) = delete;
+	Renderer &operator=(Renderer const &) = delete;
+
+	//----- vertex formats -----
+
+	//drawn with color_texture_program:
+	struct Vertex {
+		Vertex(glm::vec3 const &Position_, glm::u8vec4 const &Color_, glm::vec2 const &TexCoord_) :
+			Position(Position_), Color(Color_), TexCoord(TexCoord_) { }
+		//untextured (samples the middle of white_tex):
+		Vertex(glm::vec2 const &Position_, glm::u8vec4 const &Color_) :
+			Position(Position_, 0.0f), Color(Color_), TexCoord(0.5f, 0.5f) { }
+		glm::vec3 Position;
+		glm::u8vec4 Color;
+		glm::vec2 TexCoord;
+	};
+	static_assert(sizeof(Vertex) == 4*3 + 1*4 + 4*2, "Renderer::Vertex should be packed");
+
+	//...or, drawn with color_program, a third the size: position as 16-bit fixed point
+	// layer coordinates (CompactVertex::Extent units -> 32767) and no texcoord:
+	struct CompactVertex {
+		CompactVertex(glm::vec2 const &Position_, glm::u8vec4 const &Color_) :
+			Position(quantize(Position_)), Color(Color_) { }
+		glm::i16vec2 Position;
+		glm::u8vec4 Color;
+
+		//the scene must stay inside +/- Extent:
+		static constexpr float Extent = 16.0f;
+		static constexpr float Scale = 32767.0f / Extent;
+		//(clamped, rounded to nearest-even as SSE2's cvtps2dq does, so pack_rectangles can match)
+		static glm::i16vec2 quantize(glm::vec2 const &p) {
+			return glm::i16vec2(
+				int16_t(std::nearbyint(std::min(std::max(p.x * Scale, -32767.0f), 32767.0f))),
+				int16_t(std::nearbyint(std::min(std::max(p.y * Scale, -32767.0f), 32767.0f)))
+			);
+		}
+	};
+	static_assert(sizeof(CompactVertex) == 2*2 + 1*4, "Renderer::CompactVertex should be packed");
+
+	//----- per-frame drawing -----
+
+	//read back finished GPU timings (call once per frame, before any drawing):
+	void begin_frame();
+
+	//clear the color buffer now (not batched):
+	void clear(glm::u8vec4 const &color);
+
+	//a new layer for this frame, drawn after all earlier ones, whose coordinates map to clip space by 'object_to_clip':
+	typedef uint32_t Layer;
+	Layer layer(glm::mat4 const &object_to_clip);
+
+	//untextured rectangle (as a CCW quad) around 'center':
+	void rect(Layer layer, glm::vec2 const &center, glm::vec2 const &radius, glm::u8vec4 const &color);
+	//rectangle showing the part of 'texture' from 'tex_min' to 'tex_max', tinted by 'color':
+	void textured_rect(Layer layer, glm::vec2 const &center, glm::vec2 const &radius, GLuint texture,
+		glm::vec2 const &tex_min, glm::vec2 const &tex_max, glm::u8vec4 const &color);
+	//one-pixel-wide line from 'a' to 'b':
+	void line(Layer layer, glm::vec2 const &a, glm::vec2 const &b, glm::u8vec4 const &color);
+
+	//direct access to a layer's batches, for appending many quads at once (four vertices each, CCW);
+	// the references stay valid until flush():
+	std::vector< Vertex > &quads(Layer layer, GLuint texture = 0); //(0 = white_tex)
+	std::vector< CompactVertex > &compact_quads(Layer layer); //(positions are scaled by 1 / CompactVertex::Scale)
+
+	//upload and draw everything submitted since the last flush:
+	void flush();
+
+	//----- GL objects -----
+
+	//Shader program that draws transformed, vertices tinted with vertex colors:
+	ColorTextureProgram color_texture_program;
+
+	//Shader program for untextured (compact) vertices:
+	ColorProgram color_program;
+
+	//Solid white texture (for drawing untextured things with color_texture_program):
+	GLuint white_tex = 0;
+
+	//Static index buffer drawing each run of four vertices as a quad -- triangles (0,1,2) (0,2,3) --
+	// for up to QuadIndexQuads quads; flush() draws longer runs in pieces with a base vertex:
+	GLuint quad_index_buffer = 0;
+	static constexpr uint32_t QuadIndexQuads = 16384; //(4 * 16384 = 65536 vertices, all that uint16 indices reach)
+
+	//Buffer holding every batch's vertices during flush() (Vertex data first, then CompactVertex data):
+	GLuint vertex_buffer = 0;
+
+	//With gl_caps.persistent_mapping, vertex_buffer is instead a ring of StreamFrames regions that stays
+	// mapped; each flush() writes the next region, once the GPU is done with the draws that last read it:
+	static constexpr uint32_t StreamFrames = 3;
+	static constexpr size_t StreamRegionMinimum = sizeof(Vertex) * 32768; //(regions double from here as needed)
+	size_t stream_region_bytes = 0; //(a multiple of sizeof(Vertex), so every region starts on a boundary of both formats)
+	uint8_t *stream_mapped = nullptr;
+	uint32_t stream_region = 0; //region the next flush() writes
+	GLsync stream_fences[StreamFrames] = { }; //set after drawing from each region
+	//(re)make vertex_buffer with at least 'region_bytes' per region, and point the vertex arrays at it:
+	void allocate_stream(size_t region_bytes);
+	//wait until the next region is free (growing the ring if needed) and return where to write it:
+	uint8_t *stream_begin(size_t bytes);
+
+	//With gl_caps.indirect_draw, the draw commands for quad batches of more than QuadIndexQuads quads (built and uploaded by flush()):
+	struct DrawElementsIndirectCommand {
+		uint32_t count;
+		uint32_t instance_count;
+		uint32_t first_index;
+		int32_t base_vertex;
+		uint32_t base_instance;
+	};
+	static_assert(sizeof(DrawElementsIndirectCommand) == 20, "GL reads indirect commands as five packed 32-bit values");
+	GLuint indirect_buffer = 0;
+	std::vector< DrawElementsIndirectCommand > commands;
+
+	//Vertex Array Object that maps vertex_buffer, as Vertex, to color_texture_program attribute locations:
+	GLuint vertex_buffer_for_color_texture_program = 0;
+
+	//Vertex Array Object that maps vertex_buffer, as CompactVertex, to color_program attribute locations:
+	GLuint vertex_buffer_for_color_program = 0;
+	//(both vertex array objects bind quad_index_buffer)
+
+	//set up both vertex array objects to read from the current vertex_buffer:
+	void point_vertex_arrays();
+
+	//GPU time for the clear, upload, and draw passes (reported through the profiler):
+	GPUTimer gpu_timer;
+
+	//----- internals -----
+	enum Format : uint8_t { Full, Compact };
+	enum Primitive : uint8_t { Quads, Lines };
+	struct Batch {
+		Layer layer = 0;
+		Format format = Full;
+		Primitive primitive = Quads;
+		GLuint texture = 0;
+		std::vector< Vertex > vertices; //(Full)
+		std::vector< CompactVertex > compact; //(Compact)
+		uint32_t first = 0; //in this frame's data, in vertices of this batch's format (set during flush)
+		uint32_t command_first = 0, command_count = 0; //in commands (with gl_caps.indirect_draw, for batches of more than QuadIndexQuads quads; set during flush)
+	};
+	//batches in use are batches[0 .. batch_count); the rest keep their storage for later frames:
+	//(a deque, so adding a batch doesn't move the ones handed out by quads())
+	std::deque< Batch > batches;
+	uint32_t batch_count = 0;
+	Batch &batch(Layer layer, Format format, Primitive primitive, GLuint texture);
+
+	std::vector< glm::mat4 > layers; //object_to_clip for each layer this frame
+	std::vector< uint32_t > order; //batches in draw order (during flush)
+};
@@ -0,0 +1,47 @@
+#include "Replay.hpp"
+
+#include "read_write_chunk.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+void Replay::save(std::string const &filename) const {
+	std::ofstream out(filename, std::ios::binary);
+	if (!out) throw std::runtime_error("Failed to open '" + filename + "' for writing replay.");
+
+	std::vector< uint32_t > header{ Version, seed };
+	write_chunk("rply", header, &out);
+	write_chunk("frms", frames, &out);
+
+	if (!out) throw std::runtime_error("Failed to write replay to '" + filename + "'.");
+}
+
+Replay Replay::load(std::string const &filename) {
+	std::ifstream in(filename, std::ios::binary);
+	if (!in) throw std::runtime_error("Failed to open replay '" + filename + "'.");
+
+	std::vector< uint32_t > header;
+	read_chunk(in, "rply", &header);
+	if (header.size() != 2) throw std::runtime_error("Replay '" + filename + "' has a malformed header.");
+	if (header[0] != Version) {
+		throw std::runtime_error("Replay '" + filename + "' is version " + std::to_string(header[0]) + "; expected version " + std::to_string(Version) + ".");
+	}
+
+	Replay replay;
+	replay.seed = header[1];
+	read_chunk(in, "frms", &replay.frames);
+	return replay;
+}
+
+Replay Replay::synthetic(uint32_t seed, uint32_t frame_count, float elapsed) {
+	Replay replay;
+	replay.seed = seed;
+	replay.frames.reserve(frame_count);
+	for (uint32_t i = 0; i < frame_count; ++i) {
+		float t = i * elapsed;
+		//sweep the paddle through the whole court (update() clamps it) every ~2.5 seconds:
+		replay.frames.emplace_back(Frame{elapsed, 6.0f * std::sin(t * 2.5f)});
+	}
+	return replay;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * A Replay holds everything that feeds into PongMode's simulation:
+ *  the random seed and, per frame, the 'elapsed' passed to update()
+ *  and the (unclamped) left paddle position set by mouse input.
+ * Playing one back reproduces a session exactly, which makes it a
+ *  repeatable workload for before/after performance comparisons.
+ *
+ * File format (see read_write_chunk.hpp): 'rply' chunk of uint32 { version, seed }
+ *  followed by a 'frms' chunk of Frame.
+ */
+
+struct Replay {
+	static constexpr uint32_t Version = 1;
+
+	struct Frame {
+		float elapsed;
+		float left_paddle_y;
+	};
+	static_assert(sizeof(Frame) == 4 + 4, "Replay::Frame should be packed");
+
+	uint32_t seed = 0;
+	std::vector< Frame > frames;
+
+	//NOTE: both throw on error
+	void save(std::string const &filename) const;
+	static Replay load(std::string const &filename);
+
+	//scripted input (fixed timestep, paddle sweeping up and down) for runs without a recording:
+	static Replay synthetic(uint32_t seed, uint32_t frame_count, float elapsed);
+};
@@ -0,0 +1,79 @@
+#include "TraceWriter.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
+
+TraceWriter::TraceWriter(std::string const &filename) : out(filename, std::ios::binary) {
+	if (!out) {
+		throw std::runtime_error("Failed to open trace file '" + filename + "'.");
+	}
+	out << "{\"traceEvents\":[\n";
+	out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}}";
+	thread = std::thread(&TraceWriter::run, this);
+}
+
+TraceWriter::~TraceWriter() {
+	{
+		std::lock_guard< std::mutex > lock(mutex);
+		quit = true;
+	}
+	cv.notify_one();
+	thread.join();
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void TraceWriter::submit(std::vector< Event > &events) {
+	if (events.empty()) return;
+	{
+		std::lock_guard< std::mutex > lock(mutex);
+		if (pending.empty()) {
+			pending.swap(events);
+		} else {
+			//writer is behind; append (rare):
+			pending.insert(pending.end(), events.begin(), events.end());
+			events.clear();
+		}
+	}
+	cv.notify_one();
+}
+
+void TraceWriter::run() {
+	std::vector< Event > batch;
+	std::string text;
+	char line[256];
+	while (true) {
+		{
+			std::unique_lock< std::mutex > lock(mutex);
+			cv.wait(lock, [this](){ return quit || !pending.empty(); });
+			if (pending.empty() && quit) break;
+			batch.swap(pending);
+		}
+
+		//sort so that, within each thread, begins and ends nest properly:
+		std::sort(batch.begin(), batch.end(), [](Event const &a, Event const &b) {
+			if (a.ns != b.ns) return a.ns < b.ns;
+			if (a.begin != b.begin) return !a.begin; //close zones before opening new ones
+			return a.begin ? a.depth < b.depth : a.depth > b.depth; //outer opens first, inner closes first
+		});
+
+		if (first_event) {
+			start_ns = batch.front().ns;
+			first_event = false;
+		}
+
+		text.clear();
+		for (auto const &e : batch) {
+			uint64_t rel = e.ns - std::min(e.ns, start_ns);
+			std::snprintf(line, sizeof(line),
+				",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu64 ".%03u,\"pid\":1,\"tid\":%u}",
+				e.name, e.begin ? 'B' : 'E', rel / 1000, unsigned(rel % 1000), unsigned(e.thread)
+			);
+			text += line;
+		}
+		out.write(text.data(), text.size());
+		batch.clear();
+	}
+	out.flush();
+}
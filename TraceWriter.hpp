@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * TraceWriter streams begin/end events in Chrome's trace-event JSON format
+ *  (load the file in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * The main thread hands over one batch of events per frame with submit();
+ *  formatting and file output happen on a background thread, so enabling
+ *  tracing costs the frame loop little more than a vector swap.
+ */
+
+struct TraceWriter {
+	//opens 'filename' and starts the writer thread (throws on failure):
+	TraceWriter(std::string const &filename);
+	//flushes remaining events, closes the JSON, and joins the writer thread:
+	~TraceWriter();
+	TraceWriter(TraceWriter const &) = delete;
+	TraceWriter &operator=(TraceWriter const &) = delete;
+
+	struct Event {
+		char const *name; //must be a string literal
+		uint64_t ns; //Profiler::now_ns() timestamp
+		uint32_t thread;
+		uint32_t depth;
+		bool begin; //true for 'B', false for 'E'
+	};
+
+	//queue a frame's worth of events (any order; they are sorted before writing):
+	void submit(std::vector< Event > &events); //NOTE: swaps with 'events', which comes back empty
+
+	//---- internals ----
+	void run();
+
+	std::ofstream out;
+	uint64_t start_ns = 0; //timestamps are written relative to the first event
+	bool first_event = true;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::vector< Event > pending; //guarded by mutex
+	bool quit = false; //guarded by mutex
+	std::thread thread;
+};
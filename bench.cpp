@@ -0,0 +1,139 @@
+#include "bench.hpp"
+
+#include "collide.hpp"
+#include "cpu.hpp"
+#include "Profiler.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//run 'fn' enough times to take a few tens of milliseconds, return the best time per call in nanoseconds:
+template< typename F >
+static double time_ns(F const &fn) {
+	using Clock = std::chrono::steady_clock;
+	double best = 1e30;
+	uint32_t reps = 1;
+	for (uint32_t round = 0; round < 5; ++round) {
+		auto before = Clock::now();
+		for (uint32_t r = 0; r < reps; ++r) fn();
+		double ns = std::chrono::duration< double, std::nano >(Clock::now() - before).count() / reps;
+		best = std::min(best, ns);
+		if (ns * reps < 1e7) reps *= 4; //aim for at least ~10ms per round
+	}
+	return best;
+}
+
+void bench_paddles() {
+	//court layout matching PongMode's defaults:
+	glm::vec2 const court_radius = glm::vec2(7.0f, 5.0f);
+	glm::vec2 const paddle_radius = glm::vec2(0.2f, 1.0f);
+	glm::vec2 const ball_radius = glm::vec2(0.2f, 0.2f);
+	glm::vec2 const left_paddle = glm::vec2(-court_radius.x + 0.5f, 0.0f);
+	glm::vec2 const right_paddle = glm::vec2( court_radius.x - 0.5f, 0.0f);
+	float const scale = 4.0f / 60.0f; //one frame at the starting speed
+
+	std::cout << "ball-vs-paddle collision (ns per ball, " << isa_name(kernel_isa) << " kernels)\n";
+	std::printf("%10s %12s %12s %10s %10s\n", "balls", "generic", "x-slab", "speedup", "survivors");
+
+	std::mt19937 mt(0x0bad5eed);
+	std::uniform_real_distribution< float > x_dist(-court_radius.x + ball_radius.x, court_radius.x - ball_radius.x);
+	std::uniform_real_distribution< float > y_dist(-court_radius.y + ball_radius.y, court_radius.y - ball_radius.y);
+	std::uniform_real_distribution< float > v_dist(-1.0f, 1.0f);
+
+	for (uint32_t count : { 100U, 1000U, 10000U, 100000U, 1000000U }) {
+		std::vector< glm::vec2 > positions(count), velocities(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			positions[i] = glm::vec2(x_dist(mt), y_dist(mt));
+			velocities[i] = glm::vec2(v_dist(mt), v_dist(mt));
+		}
+		std::vector< uint8_t > near(count);
+
+		float time;
+		glm::vec2 normal;
+		uint32_t generic_hits = 0, slab_hits = 0, survivors = 0;
+
+		//what the update loop did before: full swept test against both paddles for every ball
+		double generic = time_ns([&](){
+			generic_hits = 0;
+			for (uint32_t i = 0; i < count; ++i) {
+				glm::vec2 delta = scale * velocities[i];
+				generic_hits += swept_box_vs_box(positions[i], delta, ball_radius, left_paddle, paddle_radius, &time, &normal);
+				generic_hits += swept_box_vs_box(positions[i], delta, ball_radius, right_paddle, paddle_radius, &time, &normal);
+			}
+		});
+
+		//x-slab rejection first, full test only for survivors:
+		double slab = time_ns([&](){
+			slab_hits = 0;
+			survivors = paddle_slab_candidates(positions.data(), velocities.data(), count, scale, ball_radius.x,
+				glm::vec2(left_paddle.x - paddle_radius.x, left_paddle.x + paddle_radius.x),
+				glm::vec2(right_paddle.x - paddle_radius.x, right_paddle.x + paddle_radius.x),
+				near.data());
+			for (uint32_t i = 0; i < count; ++i) {
+				if (!near[i]) continue;
+				glm::vec2 delta = scale * velocities[i];
+				slab_hits += swept_box_vs_box(positions[i], delta, ball_radius, left_paddle, paddle_radius, &time, &normal);
+				slab_hits += swept_box_vs_box(positions[i], delta, ball_radius, right_paddle, paddle_radius, &time, &normal);
+			}
+		});
+
+		if (generic_hits != slab_hits) {
+			std::cout << "MISMATCH: generic found " << generic_hits << " hits, x-slab found " << slab_hits << std::endl;
+		}
+		std::printf("%10u %12.2f %12.2f %9.2fx %9.1f%%\n", count, generic / count, slab / count, generic / slab, 100.0 * survivors / count);
+	}
+	std::cout.flush();
+}
+
+void RenderBench::frame() {
+	for (auto const &z : profiler.zones) {
+		if (std::strcmp(z.name, "frame") == 0) frame_ms.emplace_back(z.last_ms);
+		else if (std::strcmp(z.name, "update") == 0) update_ms.emplace_back(z.last_ms);
+		else if (std::strcmp(z.name, "draw") == 0) draw_ms.emplace_back(z.last_ms);
+		else if (std::strncmp(z.name, "gpu.", 4) == 0 && z.last_ms > 0.0f) {
+			auto p = std::find_if(gpu_passes.begin(), gpu_passes.end(), [&](GPUPass const &g){ return std::strcmp(g.name, z.name) == 0; });
+			if (p == gpu_passes.end()) p = gpu_passes.insert(gpu_passes.end(), GPUPass{z.name, 0.0, 0});
+			p->total_ms += z.last_ms;
+			p->timed += 1;
+		}
+	}
+}
+
+void RenderBench::print(std::string const &what, double wall_seconds) const {
+	uint32_t frames = uint32_t(frame_ms.size());
+	std::cout << "render benchmark: " << what << ", " << isa_name(kernel_isa) << " kernels\n";
+	std::printf("%u frames in %.2f s (%.1f frames per second)\n", frames, wall_seconds, frames / std::max(wall_seconds, 1e-9));
+
+	std::printf("%-14s %10s %10s %10s %10s\n", "per frame", "avg ms", "p50 ms", "p99 ms", "max ms");
+	auto row = [](char const *name, std::vector< float > ms) {
+		if (ms.empty()) return;
+		std::sort(ms.begin(), ms.end());
+		double sum = 0.0;
+		for (float m : ms) sum += m;
+		auto at = [&](float q) { return ms[std::min(size_t(q * ms.size()), ms.size() - 1)]; };
+		std::printf("%-14s %10.3f %10.3f %10.3f %10.3f\n", name, sum / ms.size(), at(0.5f), at(0.99f), ms.back());
+	};
+	row("cpu.frame", frame_ms);
+	row("cpu.update", update_ms);
+	row("cpu.draw", draw_ms);
+
+	double gpu_total = 0.0;
+	for (auto const &p : gpu_passes) {
+		double avg = p.total_ms / p.timed;
+		gpu_total += avg;
+		std::printf("%-14s %10.3f %10s (timed %u of %u frames)\n", p.name, avg, "", p.timed, frames);
+	}
+	if (gpu_passes.empty()) {
+		std::printf("(no GPU timings -- GL_TIME_ELAPSED queries never finished)\n");
+	} else {
+		std::printf("%-14s %10.3f\n", "gpu total", gpu_total);
+	}
+	std::cout.flush();
+}
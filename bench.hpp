@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Micro-benchmarks, run from the command line (see main.cpp) instead of the game.
+// Each prints a table to std::cout.
+
+//ball-vs-paddle collision: per-ball swept tests against both paddles vs.
+// the paddle_slab_candidates() broad phase followed by swept tests on survivors:
+void bench_paddles();
+
+//rendering (main.cpp's --render-bench, which runs the game offscreen):
+// call frame() after each profiler.end_frame() to collect that frame's CPU zone times and
+// whatever GPU pass times arrived, then print() for per-frame statistics over the whole run:
+struct RenderBench {
+	void frame();
+	void print(std::string const &what, double wall_seconds) const;
+
+	//per-frame CPU milliseconds:
+	std::vector< float > frame_ms, update_ms, draw_ms;
+	//GPU milliseconds per pass (passes aren't timed every frame, so each keeps its own count):
+	struct GPUPass {
+		char const *name;
+		double total_ms;
+		uint32_t timed;
+	};
+	std::vector< GPUPass > gpu_passes;
+};
@@ -0,0 +1,213 @@
+#include "collide.hpp"
+
+#include "cpu.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#ifdef CPU_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+bool swept_box_vs_box(
+	glm::vec2 const &from, glm::vec2 const &delta, glm::vec2 const &radius,
+	glm::vec2 const &box, glm::vec2 const &box_radius,
+	float *time_, glm::vec2 *normal_) {
+	assert(time_ && normal_);
+
+	//shrink the moving box to a point by growing the static box (Minkowski sum):
+	glm::vec2 extent = box_radius + radius;
+	glm::vec2 offset = from - box;
+
+	//already overlapping?
+	glm::vec2 penetration = extent - glm::abs(offset);
+	if (penetration.x > 0.0f && penetration.y > 0.0f) {
+		*time_ = 0.0f;
+		if (penetration.x > penetration.y) {
+			*normal_ = glm::vec2(0.0f, offset.y >= 0.0f ? 1.0f : -1.0f);
+		} else {
+			*normal_ = glm::vec2(offset.x >= 0.0f ? 1.0f : -1.0f, 0.0f);
+		}
+		return true;
+	}
+
+	//otherwise, intersect the ray from + t * delta with the grown box, one axis ("slab") at a time:
+	float t_enter = -std::numeric_limits< float >::infinity();
+	float t_exit = std::numeric_limits< float >::infinity();
+	glm::vec2 normal = glm::vec2(0.0f);
+	for (int axis = 0; axis < 2; ++axis) {
+		if (delta[axis] == 0.0f) {
+			//not moving along this axis, so must already be inside the slab:
+			if (std::abs(offset[axis]) >= extent[axis]) return false;
+			continue;
+		}
+		float t0 = (-extent[axis] - offset[axis]) / delta[axis];
+		float t1 = ( extent[axis] - offset[axis]) / delta[axis];
+		if (t0 > t1) std::swap(t0, t1);
+		if (t0 > t_enter) {
+			t_enter = t0;
+			normal = glm::vec2(0.0f);
+			normal[axis] = (delta[axis] > 0.0f ? -1.0f : 1.0f);
+		}
+		t_exit = std::min(t_exit, t1);
+	}
+
+	if (t_enter >= t_exit) return false; //misses (or only grazes) the box
+	if (t_enter < 0.0f || t_enter > 1.0f) return false; //contact is behind or beyond this step
+
+	*time_ = t_enter;
+	*normal_ = normal;
+	return true;
+}
+
+//---- paddle_slab_candidates, one version per instruction set ----
+//(all versions compute reach as |vx| * scale + radius, in that order, so they agree exactly)
+
+//balls [begin, count) one at a time:
+static uint32_t slab_scalar(
+	glm::vec2 const *positions, glm::vec2 const *velocities, uint32_t begin, uint32_t count,
+	float scale, float ball_radius_x,
+	glm::vec2 const &slab_a, glm::vec2 const &slab_b,
+	uint8_t *out) {
+	uint32_t survivors = 0;
+	for (uint32_t i = begin; i < count; ++i) {
+		float reach = std::abs(velocities[i].x) * scale + ball_radius_x;
+		float lo = positions[i].x - reach;
+		float hi = positions[i].x + reach;
+		bool hit = (lo < slab_a.y && hi > slab_a.x) || (lo < slab_b.y && hi > slab_b.x);
+		out[i] = uint8_t(hit);
+		survivors += uint32_t(hit);
+	}
+	return survivors;
+}
+
+#ifdef CPU_X86_KERNELS
+//writes mask bits [0, lanes) as 0/1 bytes; returns how many were set:
+static inline uint32_t mask_to_bytes(uint32_t mask, uint32_t lanes, uint8_t *out) {
+	uint32_t set = 0;
+	for (uint32_t k = 0; k < lanes; ++k) {
+		uint8_t bit = uint8_t((mask >> k) & 1);
+		out[k] = bit;
+		set += bit;
+	}
+	return set;
+}
+
+//four balls at a time:
+KERNEL_TARGET("sse2")
+static uint32_t slab_sse2(
+	glm::vec2 const *positions, glm::vec2 const *velocities, uint32_t count,
+	float scale, float ball_radius_x,
+	glm::vec2 const &slab_a, glm::vec2 const &slab_b,
+	uint8_t *out) {
+	uint32_t survivors = 0;
+	uint32_t i = 0;
+	float const *p = &positions[0].x;
+	float const *v = &velocities[0].x;
+	__m128 const a_lo = _mm_set1_ps(slab_a.x), a_hi = _mm_set1_ps(slab_a.y);
+	__m128 const b_lo = _mm_set1_ps(slab_b.x), b_hi = _mm_set1_ps(slab_b.y);
+	__m128 const scale4 = _mm_set1_ps(scale);
+	__m128 const radius4 = _mm_set1_ps(ball_radius_x);
+	__m128 const abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	for (; i + 4 <= count; i += 4) {
+		//gather x components of four (x,y) pairs:
+		__m128 x = _mm_shuffle_ps(_mm_loadu_ps(p + 2*i), _mm_loadu_ps(p + 2*i + 4), _MM_SHUFFLE(2,0,2,0));
+		__m128 vx = _mm_shuffle_ps(_mm_loadu_ps(v + 2*i), _mm_loadu_ps(v + 2*i + 4), _MM_SHUFFLE(2,0,2,0));
+		//x range the ball's edge can reach this step:
+		__m128 reach = _mm_add_ps(_mm_mul_ps(_mm_and_ps(vx, abs_mask), scale4), radius4);
+		__m128 lo = _mm_sub_ps(x, reach);
+		__m128 hi = _mm_add_ps(x, reach);
+		__m128 hit_a = _mm_and_ps(_mm_cmplt_ps(lo, a_hi), _mm_cmpgt_ps(hi, a_lo));
+		__m128 hit_b = _mm_and_ps(_mm_cmplt_ps(lo, b_hi), _mm_cmpgt_ps(hi, b_lo));
+		survivors += mask_to_bytes(uint32_t(_mm_movemask_ps(_mm_or_ps(hit_a, hit_b))), 4, out + i);
+	}
+	return survivors + slab_scalar(positions, velocities, i, count, scale, ball_radius_x, slab_a, slab_b, out);
+}
+
+//eight balls at a time:
+KERNEL_TARGET("avx2")
+static uint32_t slab_avx2(
+	glm::vec2 const *positions, glm::vec2 const *velocities, uint32_t count,
+	float scale, float ball_radius_x,
+	glm::vec2 const &slab_a, glm::vec2 const &slab_b,
+	uint8_t *out) {
+	uint32_t survivors = 0;
+	uint32_t i = 0;
+	float const *p = &positions[0].x;
+	float const *v = &velocities[0].x;
+	__m256 const a_lo = _mm256_set1_ps(slab_a.x), a_hi = _mm256_set1_ps(slab_a.y);
+	__m256 const b_lo = _mm256_set1_ps(slab_b.x), b_hi = _mm256_set1_ps(slab_b.y);
+	__m256 const scale8 = _mm256_set1_ps(scale);
+	__m256 const radius8 = _mm256_set1_ps(ball_radius_x);
+	__m256 const abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+	__m256i const order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+	for (; i + 8 <= count; i += 8) {
+		//gather x components of eight (x,y) pairs (the in-lane shuffle leaves them as 0 1 4 5 2 3 6 7):
+		__m256 x = _mm256_shuffle_ps(_mm256_loadu_ps(p + 2*i), _mm256_loadu_ps(p + 2*i + 8), _MM_SHUFFLE(2,0,2,0));
+		__m256 vx = _mm256_shuffle_ps(_mm256_loadu_ps(v + 2*i), _mm256_loadu_ps(v + 2*i + 8), _MM_SHUFFLE(2,0,2,0));
+		x = _mm256_permutevar8x32_ps(x, order);
+		vx = _mm256_permutevar8x32_ps(vx, order);
+		__m256 reach = _mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(vx, abs_mask), scale8), radius8);
+		__m256 lo = _mm256_sub_ps(x, reach);
+		__m256 hi = _mm256_add_ps(x, reach);
+		__m256 hit_a = _mm256_and_ps(_mm256_cmp_ps(lo, a_hi, _CMP_LT_OQ), _mm256_cmp_ps(hi, a_lo, _CMP_GT_OQ));
+		__m256 hit_b = _mm256_and_ps(_mm256_cmp_ps(lo, b_hi, _CMP_LT_OQ), _mm256_cmp_ps(hi, b_lo, _CMP_GT_OQ));
+		survivors += mask_to_bytes(uint32_t(_mm256_movemask_ps(_mm256_or_ps(hit_a, hit_b))), 8, out + i);
+	}
+	return survivors + slab_scalar(positions, velocities, i, count, scale, ball_radius_x, slab_a, slab_b, out);
+}
+
+//sixteen balls at a time:
+KERNEL_TARGET("avx512f")
+static uint32_t slab_avx512(
+	glm::vec2 const *positions, glm::vec2 const *velocities, uint32_t count,
+	float scale, float ball_radius_x,
+	glm::vec2 const &slab_a, glm::vec2 const &slab_b,
+	uint8_t *out) {
+	uint32_t survivors = 0;
+	uint32_t i = 0;
+	float const *p = &positions[0].x;
+	float const *v = &velocities[0].x;
+	__m512 const a_lo = _mm512_set1_ps(slab_a.x), a_hi = _mm512_set1_ps(slab_a.y);
+	__m512 const b_lo = _mm512_set1_ps(slab_b.x), b_hi = _mm512_set1_ps(slab_b.y);
+	__m512 const scale16 = _mm512_set1_ps(scale);
+	__m512 const radius16 = _mm512_set1_ps(ball_radius_x);
+	__m512i const evens = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+	__m512i const ones = _mm512_set1_epi32(1);
+	for (; i + 16 <= count; i += 16) {
+		//gather x components of sixteen (x,y) pairs:
+		__m512 x = _mm512_permutex2var_ps(_mm512_loadu_ps(p + 2*i), evens, _mm512_loadu_ps(p + 2*i + 16));
+		__m512 vx = _mm512_permutex2var_ps(_mm512_loadu_ps(v + 2*i), evens, _mm512_loadu_ps(v + 2*i + 16));
+		__m512 reach = _mm512_add_ps(_mm512_mul_ps(_mm512_abs_ps(vx), scale16), radius16);
+		__m512 lo = _mm512_sub_ps(x, reach);
+		__m512 hi = _mm512_add_ps(x, reach);
+		__mmask16 hit_a = _mm512_cmp_ps_mask(lo, a_hi, _CMP_LT_OQ) & _mm512_cmp_ps_mask(hi, a_lo, _CMP_GT_OQ);
+		__mmask16 hit_b = _mm512_cmp_ps_mask(lo, b_hi, _CMP_LT_OQ) & _mm512_cmp_ps_mask(hi, b_lo, _CMP_GT_OQ);
+		__mmask16 hit = hit_a | hit_b;
+		//mask to sixteen 0/1 bytes (vpmovdb):
+		_mm512_mask_cvtepi32_storeu_epi8(out + i, __mmask16(0xffff), _mm512_maskz_mov_epi32(hit, ones));
+		for (uint32_t m = hit; m; m &= m - 1) ++survivors;
+	}
+	return survivors + slab_scalar(positions, velocities, i, count, scale, ball_radius_x, slab_a, slab_b, out);
+}
+#endif
+
+uint32_t paddle_slab_candidates(
+	glm::vec2 const *positions, glm::vec2 const *velocities, uint32_t count,
+	float scale, float ball_radius_x,
+	glm::vec2 const &slab_a, glm::vec2 const &slab_b,
+	uint8_t *out) {
+	static_assert(sizeof(glm::vec2) == 8, "positions are read as packed (x,y) pairs");
+
+#ifdef CPU_X86_KERNELS
+	switch (kernel_isa) {
+		case ISA::AVX512: return slab_avx512(positions, velocities, count, scale, ball_radius_x, slab_a, slab_b, out);
+		case ISA::AVX2: return slab_avx2(positions, velocities, count, scale, ball_radius_x, slab_a, slab_b, out);
+		case ISA::SSE2: return slab_sse2(positions, velocities, count, scale, ball_radius_x, slab_a, slab_b, out);
+		case ISA::Scalar: break;
+	}
+#endif
+	return slab_scalar(positions, velocities, 0, count, scale, ball_radius_x, slab_a, slab_b, out);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+//Continuous (swept) collision test of a moving box against a static box.
+// The moving box has half-size 'radius' and moves from 'from' to 'from + delta';
+// the static box is centered at 'box' with half-size 'box_radius'.
+//
+//On a hit, returns true and sets:
+// *time_ -- fraction of 'delta' traveled before contact, in [0,1]
+// *normal_ -- axis-aligned contact normal, pointing out of the static box
+//Boxes that already overlap report a hit at time 0 whatever the direction of
+// motion, with the normal along the axis of least penetration (the same rule
+// the old discrete test used); callers decide what to do with those.
+//Boxes that only touch don't count as hits, and neither do separate boxes
+// moving apart (their contact would be before this step).
+bool swept_box_vs_box(
+	glm::vec2 const &from, glm::vec2 const &delta, glm::vec2 const &radius,
+	glm::vec2 const &box, glm::vec2 const &box_radius,
+	float *time_, glm::vec2 *normal_);
+
+//Broad phase for paddles: paddles sit at fixed x, so a ball can only touch one
+// if the x range it could sweep this step overlaps the paddle's x range.
+//For each of 'count' balls, sets out[i] to 1 if ball i moving by
+// 'scale' * velocities[i] could reach x within either [slab_a.x, slab_a.y] or
+// [slab_b.x, slab_b.y] (ranges of paddle *surface* x, not grown by the ball),
+// otherwise 0. Bounces never increase |velocity.x|, so this bound holds for the
+// whole step as long as the ball only moves along its velocity; callers must
+// stop trusting it once a ball is moved some other way (see PongMode::move_ball).
+//Returns the number of balls marked 1.
+//Compares 4/8/16 balls at a time with SSE2/AVX2/AVX-512, per kernel_isa (cpu.hpp).
+uint32_t paddle_slab_candidates(
+	glm::vec2 const *positions, glm::vec2 const *velocities, uint32_t count,
+	float scale, float ball_radius_x,
+	glm::vec2 const &slab_a, glm::vec2 const &slab_b,
+	uint8_t *out);
@@ -0,0 +1,67 @@
+#include "cpu.hpp"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+char const *isa_name(ISA isa) {
+	switch (isa) {
+		case ISA::Scalar: return "scalar";
+		case ISA::SSE2: return "sse2";
+		case ISA::AVX2: return "avx2";
+		case ISA::AVX512: return "avx512";
+	}
+	return "unknown";
+}
+
+static ISA detect() {
+#if defined(CPU_X86_KERNELS) && !defined(_MSC_VER)
+	//(libgcc / compiler-rt also check that the OS saves the wider registers)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return ISA::AVX512;
+	if (__builtin_cpu_supports("avx2")) return ISA::AVX2;
+	if (__builtin_cpu_supports("sse2")) return ISA::SSE2;
+	return ISA::Scalar;
+#elif defined(CPU_X86_KERNELS)
+	int regs[4];
+	__cpuid(regs, 0);
+	int max_leaf = regs[0];
+	__cpuid(regs, 1);
+	bool sse2 = (regs[3] & (1 << 26)) != 0;
+	bool osxsave = (regs[2] & (1 << 27)) != 0;
+	bool avx = (regs[2] & (1 << 28)) != 0;
+	uint64_t xcr0 = (osxsave ? _xgetbv(0) : 0);
+	bool ymm_state = (xcr0 & 0x6) == 0x6; //SSE + AVX registers saved by the OS
+	bool zmm_state = (xcr0 & 0xe6) == 0xe6; //...plus opmask and upper ZMM registers
+	bool avx2 = false, avx512f = false;
+	if (max_leaf >= 7) {
+		__cpuidex(regs, 7, 0);
+		avx2 = (regs[1] & (1 << 5)) != 0;
+		avx512f = (regs[1] & (1 << 16)) != 0;
+	}
+	if (avx && avx2 && avx512f && zmm_state) return ISA::AVX512;
+	if (avx && avx2 && ymm_state) return ISA::AVX2;
+	if (sse2) return ISA::SSE2;
+	return ISA::Scalar;
+#else
+	return ISA::Scalar;
+#endif
+}
+
+ISA best_isa() {
+	static ISA best = detect();
+	return best;
+}
+
+ISA kernel_isa = best_isa();
+
+bool set_kernel_isa(std::string const &name) {
+	for (ISA isa : { ISA::Scalar, ISA::SSE2, ISA::AVX2, ISA::AVX512 }) {
+		if (name == isa_name(isa)) {
+			if (isa > best_isa()) return false;
+			kernel_isa = isa;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/*
+ * Runtime CPU feature detection for the hand-vectorized kernels
+ *  (paddle_slab_candidates, integrate_balls, pack_rectangles).
+ *
+ * Each kernel has one version per instruction set, compiled with per-function
+ *  target attributes (so the rest of the build keeps baseline flags), and
+ *  dispatches on 'kernel_isa' -- the best set this CPU supports, unless
+ *  overridden with set_kernel_isa() (main's --isa flag) to compare paths.
+ */
+
+//instruction sets, in increasing order (each implies the ones before it):
+enum class ISA : uint8_t {
+	Scalar,
+	SSE2,
+	AVX2,
+	AVX512, //AVX-512F
+};
+
+//"scalar", "sse2", "avx2", or "avx512":
+char const *isa_name(ISA isa);
+
+//best instruction set this CPU (and OS) supports:
+ISA best_isa();
+
+//instruction set the kernels use (starts as best_isa()):
+extern ISA kernel_isa;
+
+//force the kernels to a given set by name; returns false (and changes nothing)
+// if the name is unknown or the CPU doesn't support it:
+bool set_kernel_isa(std::string const &name);
+
+//x86 kernels are only compiled where the target attribute and intrinsics headers exist.
+//(AVX-512F includes FMA, and gcc will fuse a separate mul + add into one when allowed to,
+// which rounds differently from the other paths -- so gcc gets fp-contract=off as well)
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86_KERNELS
+#define KERNEL_TARGET(ISA_STRING) __attribute__((target(ISA_STRING)))
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86_KERNELS
+#define KERNEL_TARGET(ISA_STRING) __attribute__((target(ISA_STRING), optimize("fp-contract=off")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CPU_X86_KERNELS
+#define KERNEL_TARGET(ISA_STRING)
+#endif
@@ -0,0 +1,59 @@
+#include "gl_caps.hpp"
+
+#include "log.hpp"
+
+#include <cstdlib>
+#include <string>
+
+GLCaps gl_caps;
+
+void gl_caps_init() {
+	GLCaps caps;
+
+	caps.persistent_mapping = gl_extensions.ARB_buffer_storage;
+
+	if (gl_extensions.ARB_get_program_binary) {
+		//(a driver may support the extension but offer no formats to save programs in)
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		caps.program_binaries = (formats > 0);
+	}
+
+	caps.indirect_draw = gl_extensions.ARB_draw_indirect && gl_extensions.ARB_multi_draw_indirect;
+
+	//turn off paths named in GL_CAPS_DISABLE:
+	struct { char const *name; bool *flag; } const paths[] = {
+		{ "persistent_mapping", &caps.persistent_mapping },
+		{ "program_binaries", &caps.program_binaries },
+		{ "indirect_draw", &caps.indirect_draw },
+	};
+	if (char const *disable = std::getenv("GL_CAPS_DISABLE")) {
+		std::string list = disable;
+		size_t begin = 0;
+		while (begin <= list.size()) {
+			size_t end = list.find(',', begin);
+			if (end == std::string::npos) end = list.size();
+			std::string name = list.substr(begin, end - begin);
+			bool known = false;
+			for (auto const &path : paths) {
+				if (name == path.name || name == "all") {
+					*path.flag = false;
+					known = true;
+				}
+			}
+			if (!known && !name.empty()) {
+				LOG_WARNING("GL_CAPS_DISABLE: no fast path named '" << name << "'.");
+			}
+			begin = end + 1;
+		}
+	}
+
+	gl_caps = caps;
+
+	std::string used, unused;
+	for (auto const &path : paths) {
+		std::string &to = (*path.flag ? used : unused);
+		to += (to.empty() ? "" : ", ") + std::string(path.name);
+	}
+	LOG_INFO("GL fast paths: " << (used.empty() ? "none" : used) << (unused.empty() ? "." : " (not using " + unused + ")."));
+}
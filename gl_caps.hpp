@@ -0,0 +1,40 @@
+#pragma once
+
+#include "GL.hpp"
+
+/*
+ * Optional GL fast paths, picked once at startup from what the driver offers.
+ *
+ * init_GL() loads the extensions GL.hpp knows about and notes which ones it
+ *  found in gl_extensions; gl_caps_init() checks whatever else each path needs
+ *  and fills in gl_caps, which the rendering code reads to choose between a
+ *  fast path and the plain core 3.3 one:
+ *
+ *  persistent_mapping (ARB_buffer_storage):
+ *   Renderer streams vertices into a ring buffer that stays mapped, instead of
+ *   re-specifying its vertex buffer every frame.
+ *  program_binaries (ARB_get_program_binary, with at least one binary format):
+ *   gl_compile_program keeps linked programs in gl_program_cache_dir, so later
+ *   runs skip compiling.
+ *  indirect_draw (ARB_draw_indirect + ARB_multi_draw_indirect):
+ *   Renderer issues each batch that needs several index-buffer pieces as one
+ *   glMultiDrawElementsIndirect (smaller batches use a single plain draw).
+ *
+ * (KHR_parallel_shader_compile is probed too, but nothing uses it yet:
+ *  gl_compile_program waits on each program as it goes, so compiles never overlap.)
+ *
+ * Set GL_CAPS_DISABLE=<names, comma-separated> (or "all") in the environment
+ *  to turn paths off, e.g. to compare them.
+ */
+
+struct GLCaps {
+	bool persistent_mapping = false;
+	bool program_binaries = false;
+	bool indirect_draw = false;
+};
+
+//what the rendering code may use (all false until gl_caps_init()):
+extern GLCaps gl_caps;
+
+//call once after init_GL(), before creating any programs:
+void gl_caps_init();
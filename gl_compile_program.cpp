@@ -1,9 +1,17 @@
 #include "gl_compile_program.hpp"
 
+#include "gl_caps.hpp"
+#include "log.hpp"
+#include "Profiler.hpp"
+#include "read_write_chunk.hpp"
+
+#include <cstdio>
+#include <fstream>
 #include <vector>
 #include <string>
 #include <stdexcept>
-#include <iostream>
+
+std::string gl_program_cache_dir;
 
 static GLuint gl_compile_shader(GLenum type, std::string const &source) {
 	GLuint shader = glCreateShader(type);
@@ -14,24 +22,101 @@ static GLuint gl_compile_shader(GLenum type, std::string const &source) {
 	GLint compile_status = GL_FALSE;
 	glGetShaderiv(shader, GL_COMPILE_STATUS, &compile_status);
 	if (compile_status != GL_TRUE) {
-		std::cerr << "Failed to compile shader." << std::endl;
 		GLint info_log_length = 0;
 		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &info_log_length);
 		std::vector< GLchar > info_log(info_log_length, 0);
 		GLsizei length = 0;
 		glGetShaderInfoLog(shader, GLint(info_log.size()), &length, &info_log[0]);
-		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
+		LOG_ERROR("Failed to compile shader. Info log: " << std::string(info_log.begin(), info_log.begin() + length));
 		glDeleteShader(shader);
 		throw std::runtime_error("Failed to compile shader.");
 	}
 	return shader;
 }
 
+//---- program binary cache ----
+//(files are a "pfmt" chunk holding the binary format, then a "pbin" chunk holding the binary)
+
+//cache file for a program, or "" if not caching:
+static std::string cache_path(std::string const &vertex_shader_source, std::string const &fragment_shader_source) {
+	if (!gl_caps.program_binaries || gl_program_cache_dir.empty()) return "";
+	//binaries only load on the driver that made them, so the driver is part of the key:
+	std::string key;
+	for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+		if (GLubyte const *str = glGetString(name)) key += reinterpret_cast< char const * >(str);
+		key += '\n';
+	}
+	key += vertex_shader_source;
+	key += '\0';
+	key += fragment_shader_source;
+	//64-bit FNV-1a:
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (char c : key) {
+		hash = (hash ^ uint8_t(c)) * 0x100000001b3ull;
+	}
+	char name[32];
+	std::snprintf(name, sizeof(name), "program-%016llx.bin", (unsigned long long)hash);
+	return gl_program_cache_dir + name;
+}
+
+//program loaded from a cache file, or 0 if there isn't a usable one:
+static GLuint load_cached(std::string const &path) {
+	std::ifstream from(path, std::ios::binary);
+	if (!from) return 0;
+	std::vector< uint32_t > format;
+	std::vector< uint8_t > binary;
+	try {
+		read_chunk(from, "pfmt", &format);
+		read_chunk(from, "pbin", &binary);
+	} catch (std::runtime_error &) {
+		return 0;
+	}
+	if (format.size() != 1 || binary.empty()) return 0;
+
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, format[0], binary.data(), GLsizei(binary.size()));
+	GLint link_status = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+	if (link_status != GL_TRUE) {
+		//(the driver may reject binaries at any time -- e.g., after an update -- so just compile again)
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+static void save_cached(GLuint program, std::string const &path) {
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) return;
+	std::vector< uint8_t > binary(length);
+	GLsizei written = 0;
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &written, &format, binary.data());
+	binary.resize(written);
+	if (binary.empty()) return;
+
+	std::ofstream to(path, std::ios::binary);
+	write_chunk("pfmt", std::vector< uint32_t >(1, format), &to);
+	write_chunk("pbin", binary, &to);
+	if (!to) {
+		LOG_WARNING("Failed to write program binary '" << path << "'.");
+	}
+}
+
 GLuint gl_compile_program(
 	std::string const &vertex_shader_source,
 	std::string const &fragment_shader_source
 	) {
 
+	std::string cache = cache_path(vertex_shader_source, fragment_shader_source);
+	if (!cache.empty()) {
+		if (GLuint program = load_cached(cache)) {
+			profiler.count("gl.programs_loaded");
+			return program;
+		}
+	}
+
 	GLuint vertex_shader = gl_compile_shader(GL_VERTEX_SHADER, vertex_shader_source);
 	GLuint fragment_shader = gl_compile_shader(GL_FRAGMENT_SHADER, fragment_shader_source);
 
@@ -43,20 +128,27 @@ GLuint gl_compile_program(
 	glDeleteShader(vertex_shader);
 	glDeleteShader(fragment_shader);
 
+	//ask for a binary that can be saved (must be set before linking):
+	if (!cache.empty()) {
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
 	//link the shader program and throw errors if linking fails:
 	glLinkProgram(program);
 	GLint link_status = GL_FALSE;
 	glGetProgramiv(program, GL_LINK_STATUS, &link_status);
 	if (link_status != GL_TRUE) {
-		std::cerr << "Failed to link shader program." << std::endl;
 		GLint info_log_length = 0;
 		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &info_log_length);
 		std::vector< GLchar > info_log(info_log_length, 0);
 		GLsizei length = 0;
 		glGetProgramInfoLog(program, GLint(info_log.size()), &length, &info_log[0]);
-		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
+		LOG_ERROR("Failed to link shader program. Info log: " << std::string(info_log.begin(), info_log.begin() + length));
 		throw std::runtime_error("failed to link program");
 	}
+	profiler.count("gl.programs_compiled");
+
+	if (!cache.empty()) save_cached(program, cache);
 
 	return program;
 }
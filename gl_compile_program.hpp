@@ -6,6 +6,11 @@
 
 //compiles+links an OpenGL shader program from source.
 // throws on compilation error.
+//with gl_caps.program_binaries, linked programs are saved to (and later loaded from)
+// gl_program_cache_dir, keyed by their source and the driver:
 GLuint gl_compile_program(
 	std::string const &vertex_shader_source,
 	std::string const &fragment_shader_source);
+
+//where gl_compile_program keeps program binaries, ending in a path separator ("" = don't cache):
+extern std::string gl_program_cache_dir;
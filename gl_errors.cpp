@@ -0,0 +1,63 @@
+#include "gl_errors.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+uint32_t gl_errors_sample = 1;
+
+#ifndef NDEBUG
+static char const *debug_type_name(GLenum type) {
+	switch (type) {
+		case GL_DEBUG_TYPE_ERROR: return "error";
+		case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+		case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+		case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+		case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+		default: return "other";
+	}
+}
+
+//may be called from a driver thread (the logger is fine with that):
+static void APIENTRY debug_output(GLenum, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, const void *) {
+	std::string text(message, length >= 0 ? size_t(length) : std::strlen(message));
+	if (severity == GL_DEBUG_SEVERITY_HIGH || type == GL_DEBUG_TYPE_ERROR) {
+		LOG_ERROR("gl " << debug_type_name(type) << " (" << id << "): " << text);
+	} else if (severity == GL_DEBUG_SEVERITY_MEDIUM || severity == GL_DEBUG_SEVERITY_LOW) {
+		LOG_WARNING("gl " << debug_type_name(type) << " (" << id << "): " << text);
+	} else {
+		LOG_DEBUG("gl " << debug_type_name(type) << " (" << id << "): " << text);
+	}
+}
+#endif
+
+bool gl_debug_output_init() {
+	bool installed = false;
+
+#ifndef NDEBUG
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	//(KHR_debug's functions are loaded, and its availability checked, by init_GL -- see GL.hpp)
+	if ((flags & GL_CONTEXT_FLAG_DEBUG_BIT) && gl_extensions.KHR_debug) {
+		glEnable(GL_DEBUG_OUTPUT);
+		glDebugMessageCallback(debug_output, nullptr);
+		//notifications (buffer placement hints and the like) are chatty; keep them out:
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+		installed = true;
+	}
+#endif
+
+	gl_errors_sample = (installed ? 0 : 1);
+	if (char const *sample = std::getenv("GL_ERRORS_SAMPLE")) {
+		gl_errors_sample = uint32_t(std::strtoul(sample, nullptr, 10));
+	}
+
+#ifndef NDEBUG
+	if (installed) {
+		LOG_INFO("GL errors: reported by debug output callback" << (gl_errors_sample ? ", plus glGetError() every " + std::to_string(gl_errors_sample) + " checks." : "."));
+	} else {
+		LOG_INFO("GL errors: no debug output; glGetError() every " << gl_errors_sample << " checks.");
+	}
+#endif
+	return installed;
+}
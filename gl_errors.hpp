@@ -1,17 +1,36 @@
 #pragma once
 
 #include "GL.hpp"
-#include <iostream>
+#include "log.hpp"
+
+#include <cstdint>
 
 #define STR2(X) # X
 #define STR(X) STR2(X)
 
-inline void gl_errors(std::string const &where) {
+/*
+ * GL error reporting:
+ *  - NDEBUG builds: GL_ERRORS() compiles to nothing.
+ *  - otherwise, if the context supports KHR_debug, gl_debug_output_init() installs
+ *    a callback that logs errors as the driver reports them, and GL_ERRORS() stops
+ *    calling glGetError() (which waits on the driver).
+ *  - without the callback, each GL_ERRORS() site checks glGetError() on every
+ *    gl_errors_sample'th call.
+ * Set GL_ERRORS_SAMPLE=<n> in the environment to override the sampling period (0 = never).
+ */
+
+//call once after init_GL(); returns true if the debug output callback is installed:
+bool gl_debug_output_init();
+
+//check glGetError() at every n'th call of each GL_ERRORS() site (0 = never):
+extern uint32_t gl_errors_sample;
+
+inline void gl_errors(char const *where) {
 	GLenum err = 0;
 	while ((err = glGetError()) != GL_NO_ERROR) {
 		#define CHECK( ERR ) \
 			if (err == ERR) { \
-				std::cerr << "WARNING: gl error '" #ERR "' at " << where << std::endl; \
+				LOG_WARNING("gl error '" #ERR "' at " << where); \
 			} else
 
 		CHECK( GL_INVALID_ENUM )
@@ -22,10 +41,20 @@ inline void gl_errors(std::string const &where) {
 		CHECK( GL_STACK_UNDERFLOW )
 		CHECK( GL_STACK_OVERFLOW )
 		{
-			std::cerr << "WARNING: gl error '" << err << "'" << std::endl;
+			LOG_WARNING("gl error '" << err << "' at " << where);
 		}
 		#undef CHECK
 	}
 }
-#define GL_ERRORS() gl_errors(__FILE__  ":" STR(__LINE__) )
 
+#ifdef NDEBUG
+#define GL_ERRORS() do { } while (0)
+#else
+#define GL_ERRORS() \
+	do { \
+		static uint32_t gl_errors_calls_ = 0; \
+		if (gl_errors_sample != 0 && ++gl_errors_calls_ % gl_errors_sample == 0) { \
+			gl_errors(__FILE__  ":" STR(__LINE__)); \
+		} \
+	} while (0)
+#endif
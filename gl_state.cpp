@@ -0,0 +1,108 @@
+#include "gl_state.hpp"
+
+#include "Profiler.hpp"
+
+GLState gl_state;
+
+constexpr GLuint GLState::Unknown;
+
+static int32_t cap_index(GLenum cap) {
+	switch (cap) {
+		case GL_BLEND: return GLState::Blend;
+		case GL_DEPTH_TEST: return GLState::DepthTest;
+		case GL_CULL_FACE: return GLState::CullFace;
+		case GL_SCISSOR_TEST: return GLState::ScissorTest;
+		default: return -1;
+	}
+}
+
+void GLState::enable(GLenum cap) {
+	int32_t i = cap_index(cap);
+	if (i >= 0 && same(caps[i], uint8_t(1))) return;
+	if (i < 0) ++issued;
+	glEnable(cap);
+}
+
+void GLState::disable(GLenum cap) {
+	int32_t i = cap_index(cap);
+	if (i >= 0 && same(caps[i], uint8_t(0))) return;
+	if (i < 0) ++issued;
+	glDisable(cap);
+}
+
+void GLState::blend_func(GLenum sfactor, GLenum dfactor) {
+	if (blend_src == sfactor && blend_dst == dfactor) {
+		++skipped;
+		return;
+	}
+	++issued;
+	blend_src = sfactor;
+	blend_dst = dfactor;
+	glBlendFunc(sfactor, dfactor);
+}
+
+void GLState::clear_color(float r, float g, float b, float a) {
+	if (clear_color_known && clear_rgba[0] == r && clear_rgba[1] == g && clear_rgba[2] == b && clear_rgba[3] == a) {
+		++skipped;
+		return;
+	}
+	++issued;
+	clear_color_known = true;
+	clear_rgba[0] = r; clear_rgba[1] = g; clear_rgba[2] = b; clear_rgba[3] = a;
+	glClearColor(r, g, b, a);
+}
+
+void GLState::use_program(GLuint program_) {
+	if (same(program, program_)) return;
+	glUseProgram(program_);
+}
+
+void GLState::bind_vertex_array(GLuint array) {
+	if (same(vertex_array, array)) return;
+	glBindVertexArray(array);
+}
+
+void GLState::bind_buffer(GLenum target, GLuint buffer) {
+	if (target == GL_ARRAY_BUFFER) {
+		if (same(array_buffer, buffer)) return;
+	} else if (target == GL_DRAW_INDIRECT_BUFFER) {
+		if (same(draw_indirect_buffer, buffer)) return;
+	} else {
+		++issued;
+	}
+	glBindBuffer(target, buffer);
+}
+
+void GLState::active_texture(GLenum texture) {
+	if (same(texture_unit, texture)) return;
+	glActiveTexture(texture);
+}
+
+void GLState::bind_texture(GLenum target, GLuint texture) {
+	uint32_t unit = texture_unit - GL_TEXTURE0;
+	if (target == GL_TEXTURE_2D && texture_unit != Unknown && unit < TextureUnits) {
+		if (same(textures[unit], texture)) return;
+	} else {
+		++issued;
+	}
+	glBindTexture(target, texture);
+}
+
+void GLState::invalidate() {
+	for (auto &cap : caps) cap = 2;
+	blend_src = blend_dst = Unknown;
+	clear_color_known = false;
+	program = Unknown;
+	vertex_array = Unknown;
+	array_buffer = Unknown;
+	draw_indirect_buffer = Unknown;
+	texture_unit = Unknown;
+	for (auto &texture : textures) texture = Unknown;
+}
+
+void GLState::report_frame() {
+	profiler.count("gl.issued", issued);
+	profiler.count("gl.skipped", skipped);
+	issued = 0;
+	skipped = 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <cstdint>
+
+/*
+ * gl_state tracks the GL state the renderer sets every frame -- capabilities,
+ *  blend function, clear color, bound program, vertex array, array and draw
+ *  indirect buffers, and textures -- and skips calls that wouldn't change it.
+ *
+ * Every call through gl_state counts as issued or skipped; report_frame()
+ *  (Renderer::flush calls it) adds the frame's counts to the profiler as the
+ *  "gl.issued" and "gl.skipped" counters.
+ *
+ * NOTE: the cache only knows about changes made through it. Code that sets
+ *  any of this state with plain gl* calls (e.g., setting up a vertex array
+ *  object, uploading a texture) or deletes a bound object should call
+ *  gl_state.invalidate() afterward.
+ *  Until something is set through the cache, its value is unknown, so the
+ *  first call always goes through.
+ */
+
+struct GLState {
+	void enable(GLenum cap);
+	void disable(GLenum cap);
+	void blend_func(GLenum sfactor, GLenum dfactor);
+	void clear_color(float r, float g, float b, float a);
+	void use_program(GLuint program);
+	void bind_vertex_array(GLuint array);
+	void bind_buffer(GLenum target, GLuint buffer); //(GL_ELEMENT_ARRAY_BUFFER is vertex array state, so it's never cached)
+	void active_texture(GLenum texture);
+	void bind_texture(GLenum target, GLuint texture); //(on the active texture unit)
+
+	//forget everything (the next call to each function goes through):
+	void invalidate();
+
+	//add this frame's counts to the profiler and reset them:
+	void report_frame();
+
+	uint32_t issued = 0;
+	uint32_t skipped = 0;
+
+	//---- internals ----
+	static constexpr GLuint Unknown = ~GLuint(0);
+	static constexpr uint32_t TextureUnits = 8; //(units past this aren't cached)
+
+	enum Cap : uint8_t { Blend, DepthTest, CullFace, ScissorTest, CapCount };
+	uint8_t caps[CapCount]; //0 = disabled, 1 = enabled, 2 = unknown
+	GLenum blend_src = Unknown, blend_dst = Unknown;
+	bool clear_color_known = false;
+	float clear_rgba[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	GLuint program = Unknown;
+	GLuint vertex_array = Unknown;
+	GLuint array_buffer = Unknown;
+	GLuint draw_indirect_buffer = Unknown;
+	GLenum texture_unit = Unknown; //as GL_TEXTURE0 + i
+	GLuint textures[TextureUnits]; //GL_TEXTURE_2D binding for each unit
+
+	GLState() { invalidate(); }
+
+	//true (and counted as skipped) if 'value' is already 'known'; otherwise counted as issued and stored:
+	template< typename T >
+	bool same(T &known, T value) {
+		if (known == value) {
+			++skipped;
+			return true;
+		}
+		++issued;
+		known = value;
+		return false;
+	}
+};
+
+extern GLState gl_state;
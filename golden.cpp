@@ -0,0 +1,234 @@
+#include "golden.hpp"
+
+#include "PongMode.hpp"
+#include "OffscreenTarget.hpp"
+#include "Replay.hpp"
+#include "load_save_png.hpp"
+#include "cpu.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef CPU_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+//---- image diff ----
+
+static glm::u8vec4 const OverColor = glm::u8vec4(0xff, 0x00, 0xff, 0xff);
+
+static void diff_scalar(glm::u8vec4 const *golden, glm::u8vec4 const *image, size_t begin, size_t count, uint8_t tolerance, glm::u8vec4 *diff_image, ImageDiff *result) {
+	for (size_t i = begin; i < count; ++i) {
+		uint8_t delta = 0;
+		for (uint32_t c = 0; c < 4; ++c) {
+			delta = std::max(delta, uint8_t(std::max(golden[i][c], image[i][c]) - std::min(golden[i][c], image[i][c])));
+		}
+		result->max_delta = std::max(result->max_delta, delta);
+		bool over = (delta > tolerance);
+		result->over += (over ? 1 : 0);
+		if (diff_image) {
+			diff_image[i] = (over ? OverColor : glm::u8vec4(golden[i].r >> 2, golden[i].g >> 2, golden[i].b >> 2, 0xff));
+		}
+	}
+}
+
+#ifdef CPU_X86_KERNELS
+//four pixels per step; absolute difference as the OR of both saturating subtractions:
+KERNEL_TARGET("sse2")
+static void diff_sse2(glm::u8vec4 const *golden, glm::u8vec4 const *image, size_t count, uint8_t tolerance, glm::u8vec4 *diff_image, ImageDiff *result) {
+	static_assert(sizeof(glm::u8vec4) == 4, "pixels are read as packed RGBA");
+	__m128i const tol = _mm_set1_epi8(char(tolerance));
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const dim_mask = _mm_set1_epi32(0x003f3f3f); //(r g b) >> 2, alpha cleared...
+	__m128i const opaque = _mm_set1_epi32(int32_t(0xff000000)); //...then set to 0xff
+	__m128i const over_color = _mm_set1_epi32(int32_t(0xffff00ff)); //OverColor
+	__m128i max_delta = zero;
+	uint32_t over = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i g = _mm_loadu_si128(reinterpret_cast< __m128i const * >(golden + i));
+		__m128i m = _mm_loadu_si128(reinterpret_cast< __m128i const * >(image + i));
+		__m128i delta = _mm_or_si128(_mm_subs_epu8(g, m), _mm_subs_epu8(m, g));
+		max_delta = _mm_max_epu8(max_delta, delta);
+		//pixels where any channel's delta exceeds the tolerance (all-ones lanes):
+		__m128i over_mask = _mm_xor_si128(_mm_cmpeq_epi32(_mm_subs_epu8(delta, tol), zero), _mm_set1_epi32(-1));
+		int bits = _mm_movemask_ps(_mm_castsi128_ps(over_mask));
+		over += uint32_t((bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) + ((bits >> 3) & 1));
+		if (diff_image) {
+			__m128i dim = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(g, 2), dim_mask), opaque);
+			__m128i out = _mm_or_si128(_mm_and_si128(over_mask, over_color), _mm_andnot_si128(over_mask, dim));
+			_mm_storeu_si128(reinterpret_cast< __m128i * >(diff_image + i), out);
+		}
+	}
+	//horizontal max of the sixteen byte lanes:
+	alignas(16) uint8_t lanes[16];
+	_mm_store_si128(reinterpret_cast< __m128i * >(lanes), max_delta);
+	for (uint8_t l : lanes) result->max_delta = std::max(result->max_delta, l);
+	result->over += over;
+
+	diff_scalar(golden, image, i, count, tolerance, diff_image, result);
+}
+#endif
+
+ImageDiff diff_images(glm::u8vec4 const *golden, glm::u8vec4 const *image, size_t count, uint8_t tolerance, glm::u8vec4 *diff_image) {
+	ImageDiff result;
+#ifdef CPU_X86_KERNELS
+	if (kernel_isa >= ISA::SSE2) {
+		diff_sse2(golden, image, count, tolerance, diff_image, &result);
+		return result;
+	}
+#endif
+	diff_scalar(golden, image, 0, count, tolerance, diff_image, &result);
+	return result;
+}
+
+int golden_selftest() {
+#ifdef CPU_X86_KERNELS
+	if (kernel_isa < ISA::SSE2) {
+		std::cout << "golden selftest: nothing to check with " << isa_name(kernel_isa) << " kernels." << std::endl;
+		return 0;
+	}
+	std::mt19937 mt(0);
+	uint32_t cases = 0, failed = 0;
+	//(counts that aren't a multiple of four exercise the scalar tail after the SSE2 loop)
+	for (size_t count : { 0, 1, 3, 4, 5, 17, 1000, 480 * 360 + 3 }) {
+		for (uint8_t spread : { 0, 1, 3, 40, 255 }) {
+			//a random golden, and an image that differs from it by up to 'spread' in some channels:
+			std::vector< glm::u8vec4 > golden(count), image(count);
+			for (size_t i = 0; i < count; ++i) {
+				for (uint32_t c = 0; c < 4; ++c) {
+					golden[i][c] = uint8_t(mt());
+					int32_t delta = (mt() % 2 ? int32_t(mt() % (2 * uint32_t(spread) + 1)) - int32_t(spread) : 0);
+					image[i][c] = uint8_t(std::min(255, std::max(0, int32_t(golden[i][c]) + delta)));
+				}
+			}
+			for (uint8_t tolerance : { 0, 2, 30, 255 }) {
+				ImageDiff scalar, sse2;
+				std::vector< glm::u8vec4 > scalar_diff(count), sse2_diff(count);
+				diff_scalar(golden.data(), image.data(), 0, count, tolerance, scalar_diff.data(), &scalar);
+				diff_sse2(golden.data(), image.data(), count, tolerance, sse2_diff.data(), &sse2);
+				cases += 1;
+				if (scalar.over != sse2.over || scalar.max_delta != sse2.max_delta || scalar_diff != sse2_diff) {
+					failed += 1;
+					std::cout << "golden selftest: " << count << " pixels, spread " << int(spread) << ", tolerance " << int(tolerance)
+						<< ": scalar over " << scalar.over << " max_delta " << int(scalar.max_delta)
+						<< ", sse2 over " << sse2.over << " max_delta " << int(sse2.max_delta)
+						<< (scalar_diff != sse2_diff ? ", diff images differ." : ".") << std::endl;
+				}
+			}
+		}
+	}
+	std::cout << "golden selftest: SSE2 and scalar diffs " << (failed ? "disagree in " + std::to_string(failed) + " of " : std::string("agree in all "))
+		<< cases << " cases." << std::endl;
+	return (failed ? 1 : 0);
+#else
+	std::cout << "golden selftest: no SSE2 version in this build." << std::endl;
+	return 0;
+#endif
+}
+
+//---- golden cases ----
+
+namespace {
+	struct GoldenCase {
+		char const *name;
+		uint32_t seed;
+		uint32_t frames; //of Replay::synthetic input at 60Hz before drawing
+	};
+	GoldenCase const Cases[] = {
+		{ "start", std::mt19937::default_seed, 0 }, //(as the game starts)
+		{ "rally", 1, 600 },
+		{ "late", 2, 3600 },
+	};
+
+	//render size (small, to keep the goldens small):
+	glm::uvec2 const Size = glm::uvec2(480, 360);
+	//per-channel difference allowed anywhere (drivers blend and rasterize slightly differently)...
+	uint8_t const Tolerance = 2;
+	//...and fraction of pixels allowed past it (rectangle edges may land on a different pixel):
+	float const MaxOverFraction = 0.001f;
+}
+
+int run_golden(std::string const &dir, bool update, std::shared_ptr< Renderer > const &renderer) {
+	OffscreenTarget target(Size);
+	target.bind();
+
+	uint32_t failed = 0;
+	for (GoldenCase const &c : Cases) {
+		//play the scripted input, then draw each format:
+		PongMode pong(c.seed, renderer);
+		Replay input = Replay::synthetic(c.seed, c.frames, 1.0f / 60.0f);
+		for (Replay::Frame const &frame : input.frames) {
+			pong.left_paddle.y = frame.left_paddle_y;
+			pong.update(frame.elapsed);
+		}
+
+		std::string golden_file = dir + "/" + c.name + ".png";
+		glm::uvec2 golden_size(0);
+		std::vector< glm::u8vec4 > golden;
+		if (!update) {
+			try {
+				load_png(golden_file, &golden_size, &golden, LowerLeftOrigin);
+			} catch (std::exception const &e) {
+				LOG_ERROR("golden " << c.name << ": can't load '" << golden_file << "' (" << e.what() << "); run with --golden-update to create it.");
+				++failed;
+				continue;
+			}
+		}
+
+		for (bool compact : { false, true }) {
+			char const *format = (compact ? "compact" : "full");
+			pong.compact_vertices = compact;
+			renderer->begin_frame();
+			pong.draw(Size);
+			renderer->flush();
+
+			std::vector< glm::u8vec4 > image;
+			target.read_pixels(&image);
+			for (auto &px : image) {
+				px.a = 0xff; //(as screenshots do)
+			}
+
+			if (update) {
+				//the full format is the reference; the compact one just has to match it:
+				if (!compact) {
+					save_png(golden_file, Size, image.data(), LowerLeftOrigin);
+					std::cout << "golden " << c.name << ": wrote '" << golden_file << "'." << std::endl;
+				}
+				continue;
+			}
+
+			std::string base = dir + "/" + c.name + "." + format;
+			if (golden_size != Size) {
+				std::cout << "golden " << c.name << " (" << format << "): FAIL, golden is " << golden_size.x << "x" << golden_size.y
+					<< " but renders are " << Size.x << "x" << Size.y << "." << std::endl;
+				save_png(base + ".png", Size, image.data(), LowerLeftOrigin);
+				++failed;
+				continue;
+			}
+
+			std::vector< glm::u8vec4 > diff(image.size());
+			ImageDiff result = diff_images(golden.data(), image.data(), image.size(), Tolerance, diff.data());
+			bool pass = (result.over <= uint32_t(MaxOverFraction * image.size()));
+			std::cout << "golden " << c.name << " (" << format << "): " << (pass ? "ok" : "FAIL")
+				<< ", " << result.over << " pixels over tolerance, max channel delta " << uint32_t(result.max_delta) << "." << std::endl;
+			if (!pass) {
+				save_png(base + ".png", Size, image.data(), LowerLeftOrigin);
+				save_png(base + ".diff.png", Size, diff.data(), LowerLeftOrigin);
+				std::cout << "  wrote '" << base << ".png' and '" << base << ".diff.png'." << std::endl;
+				++failed;
+			}
+		}
+	}
+
+	if (!update) {
+		std::cout << (failed ? "golden: " + std::to_string(failed) + " failed." : std::string("golden: all passed.")) << std::endl;
+	}
+	return (failed ? 1 : 0);
+}
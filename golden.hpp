@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct Renderer;
+
+/*
+ * Golden-image render checks (main.cpp's --golden <dir>).
+ *
+ * run_golden renders a fixed set of PongMode states (seed + scripted input for
+ *  a number of frames) offscreen, once per vertex format, and compares each
+ *  image against <dir>/<case>.png. Images that differ by more than the per-
+ *  channel tolerance in more than a few pixels fail, and the render and a diff
+ *  image (differing pixels magenta over a darkened golden) are written next to
+ *  the golden as <case>.<format>.png and <case>.<format>.diff.png.
+ *
+ * With 'update', the full-format renders are written as the new goldens instead.
+ *
+ * Needs a current GL context (and a Renderer made in it); returns the process
+ *  exit code (0 if all passed).
+ */
+int run_golden(std::string const &dir, bool update, std::shared_ptr< Renderer > const &renderer);
+
+//per-pixel comparison of 'count' RGBA pixels (SSE2 where available):
+struct ImageDiff {
+	uint32_t over = 0; //pixels with some channel differing by more than 'tolerance'
+	uint8_t max_delta = 0; //largest per-channel difference anywhere
+};
+//'diff_image' (if not null) gets the visualization described above:
+ImageDiff diff_images(glm::u8vec4 const *golden, glm::u8vec4 const *image, size_t count, uint8_t tolerance, glm::u8vec4 *diff_image);
+
+//check the SSE2 diff_images against the scalar one on generated images (main.cpp's --golden-selftest);
+// returns the process exit code (0 if they agree everywhere, or if there's no SSE2 version to check):
+int golden_selftest();
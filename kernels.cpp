@@ -0,0 +1,199 @@
+#include "kernels.hpp"
+
+#include "cpu.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#ifdef CPU_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+//---- integrate_balls ----
+//(positions and velocities are treated as flat arrays of 2 * count floats)
+
+static void integrate_scalar(float *p, float const *v, uint32_t begin, uint32_t floats, float scale) {
+	for (uint32_t k = begin; k < floats; ++k) {
+		p[k] += scale * v[k];
+	}
+}
+
+#ifdef CPU_X86_KERNELS
+KERNEL_TARGET("sse2")
+static void integrate_sse2(float *p, float const *v, uint32_t floats, float scale) {
+	__m128 const scale4 = _mm_set1_ps(scale);
+	uint32_t k = 0;
+	for (; k + 4 <= floats; k += 4) {
+		_mm_storeu_ps(p + k, _mm_add_ps(_mm_loadu_ps(p + k), _mm_mul_ps(scale4, _mm_loadu_ps(v + k))));
+	}
+	integrate_scalar(p, v, k, floats, scale);
+}
+
+KERNEL_TARGET("avx2")
+static void integrate_avx2(float *p, float const *v, uint32_t floats, float scale) {
+	__m256 const scale8 = _mm256_set1_ps(scale);
+	uint32_t k = 0;
+	for (; k + 8 <= floats; k += 8) {
+		_mm256_storeu_ps(p + k, _mm256_add_ps(_mm256_loadu_ps(p + k), _mm256_mul_ps(scale8, _mm256_loadu_ps(v + k))));
+	}
+	integrate_scalar(p, v, k, floats, scale);
+}
+
+KERNEL_TARGET("avx512f")
+static void integrate_avx512(float *p, float const *v, uint32_t floats, float scale) {
+	__m512 const scale16 = _mm512_set1_ps(scale);
+	uint32_t k = 0;
+	for (; k + 16 <= floats; k += 16) {
+		_mm512_storeu_ps(p + k, _mm512_add_ps(_mm512_loadu_ps(p + k), _mm512_mul_ps(scale16, _mm512_loadu_ps(v + k))));
+	}
+	//masked tail instead of a scalar loop:
+	if (k < floats) {
+		__mmask16 tail = __mmask16((1u << (floats - k)) - 1);
+		__m512 pk = _mm512_maskz_loadu_ps(tail, p + k);
+		__m512 vk = _mm512_maskz_loadu_ps(tail, v + k);
+		_mm512_mask_storeu_ps(p + k, tail, _mm512_add_ps(pk, _mm512_mul_ps(scale16, vk)));
+	}
+}
+#endif
+
+void integrate_balls(glm::vec2 *positions, glm::vec2 const *velocities, uint32_t count, float scale) {
+	static_assert(sizeof(glm::vec2) == 8, "positions are read as packed (x,y) pairs");
+	if (count == 0) return;
+	float *p = &positions[0].x;
+	float const *v = &velocities[0].x;
+
+#ifdef CPU_X86_KERNELS
+	switch (kernel_isa) {
+		case ISA::AVX512: integrate_avx512(p, v, 2 * count, scale); return;
+		case ISA::AVX2: integrate_avx2(p, v, 2 * count, scale); return;
+		case ISA::SSE2: integrate_sse2(p, v, 2 * count, scale); return;
+		case ISA::Scalar: break;
+	}
+#endif
+	integrate_scalar(p, v, 0, 2 * count, scale);
+}
+
+//---- pack_rectangles ----
+//(corners in quad order: (x0,y0) (x1,y0) (x1,y1) (x0,y1), where x0 = x - radius.x and so on)
+
+static void pack_scalar(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color, PongMode::Vertex *out) {
+	for (uint32_t i = 0; i < count; ++i) {
+		glm::vec2 const &center = centers[i];
+		*(out++) = PongMode::Vertex(glm::vec2(center.x-radius.x, center.y-radius.y), color);
+		*(out++) = PongMode::Vertex(glm::vec2(center.x+radius.x, center.y-radius.y), color);
+		*(out++) = PongMode::Vertex(glm::vec2(center.x+radius.x, center.y+radius.y), color);
+		*(out++) = PongMode::Vertex(glm::vec2(center.x-radius.x, center.y+radius.y), color);
+	}
+}
+
+#ifdef CPU_X86_KERNELS
+//[x y x y] from one center:
+//(_mm_loadl_epi64 reads through an aliasing-safe type, unlike loading the pair as a double)
+KERNEL_TARGET("sse2")
+static inline __m128 load_center2(glm::vec2 const *center) {
+	__m128 c = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast< __m128i const * >(center)));
+	return _mm_movelh_ps(c, c);
+}
+
+//Vertices are 24 bytes (x y z color s t), so two of them fill exactly three 16-byte stores:
+// [a.x a.y 0 color] [0.5 0.5 b.x b.y] [0 color 0.5 0.5]
+//(wider registers don't line up with 24-byte vertices, so the AVX paths use this one too)
+KERNEL_TARGET("sse2")
+static void pack_sse2(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color, PongMode::Vertex *out) {
+	static_assert(sizeof(PongMode::Vertex) == 24, "pack_sse2 writes 24-byte vertices");
+	float color_bits;
+	std::memcpy(&color_bits, &color, 4);
+	__m128 const tail = _mm_setr_ps(0.0f, color_bits, 0.5f, 0.5f); //z, color, s, t
+	__m128 const half = _mm_set1_ps(0.5f);
+	__m128 const offset = _mm_setr_ps(-radius.x, -radius.y, radius.x, radius.y);
+	float *f = reinterpret_cast< float * >(out);
+	for (uint32_t i = 0; i < count; ++i) {
+		//corners as [x0 y0 x1 y1] (center - radius is computed as center + -radius, which is exact):
+		__m128 c = load_center2(&centers[i]);
+		__m128 corners = _mm_add_ps(c, offset);
+		__m128 v0 = corners; //(x0, y0)
+		__m128 v1 = _mm_shuffle_ps(corners, corners, _MM_SHUFFLE(0,0,1,2)); //(x1, y0)
+		__m128 v2 = _mm_movehl_ps(corners, corners); //(x1, y1)
+		__m128 v3 = _mm_shuffle_ps(corners, corners, _MM_SHUFFLE(0,0,3,0)); //(x0, y1)
+		//quad (v0 v1 v2 v3), written as pairs:
+		_mm_storeu_ps(f + 0, _mm_movelh_ps(v0, tail));
+		_mm_storeu_ps(f + 4, _mm_movelh_ps(half, v1));
+		_mm_storeu_ps(f + 8, tail);
+		_mm_storeu_ps(f + 12, _mm_movelh_ps(v2, tail));
+		_mm_storeu_ps(f + 16, _mm_movelh_ps(half, v3));
+		_mm_storeu_ps(f + 20, tail);
+		f += 24;
+	}
+}
+#endif
+
+static void pack_compact_scalar(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color, PongMode::CompactVertex *out) {
+	for (uint32_t i = 0; i < count; ++i) {
+		glm::vec2 const &center = centers[i];
+		*(out++) = PongMode::CompactVertex(glm::vec2(center.x-radius.x, center.y-radius.y), color);
+		*(out++) = PongMode::CompactVertex(glm::vec2(center.x+radius.x, center.y-radius.y), color);
+		*(out++) = PongMode::CompactVertex(glm::vec2(center.x+radius.x, center.y+radius.y), color);
+		*(out++) = PongMode::CompactVertex(glm::vec2(center.x-radius.x, center.y+radius.y), color);
+	}
+}
+
+#ifdef CPU_X86_KERNELS
+//Compact vertices are 8 bytes (x y as int16, color), so a quad is exactly two 16-byte stores.
+//The four corners quantize together as [x0 y0 x1 y1] in the low half of one register:
+KERNEL_TARGET("sse2")
+static void pack_compact_sse2(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color, PongMode::CompactVertex *out) {
+	static_assert(sizeof(PongMode::CompactVertex) == 8, "pack_compact_sse2 writes 8-byte vertices");
+	int32_t color_bits;
+	std::memcpy(&color_bits, &color, 4);
+	__m128i const color4 = _mm_set1_epi32(color_bits);
+	__m128 const scale = _mm_set1_ps(PongMode::CompactVertex::Scale);
+	__m128 const lo = _mm_set1_ps(-32767.0f);
+	__m128 const hi = _mm_set1_ps(32767.0f);
+	__m128 const offset = _mm_setr_ps(-radius.x, -radius.y, radius.x, radius.y);
+	__m128i *o = reinterpret_cast< __m128i * >(out);
+	for (uint32_t i = 0; i < count; ++i) {
+		__m128 c = load_center2(&centers[i]);
+		__m128 corners = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_add_ps(c, offset), scale), lo), hi);
+		__m128i q = _mm_cvtps_epi32(corners); //(rounds to nearest-even, like std::nearbyint)
+		q = _mm_packs_epi32(q, q); //int16 [x0 y0 x1 y1 ...]
+		//pairs of positions, then interleaved with the color:
+		__m128i v0v1 = _mm_shufflelo_epi16(q, _MM_SHUFFLE(1,2,1,0)); //(x0,y0) (x1,y0)
+		__m128i v2v3 = _mm_shufflelo_epi16(q, _MM_SHUFFLE(3,0,3,2)); //(x1,y1) (x0,y1)
+		_mm_storeu_si128(o + 0, _mm_unpacklo_epi32(v0v1, color4));
+		_mm_storeu_si128(o + 1, _mm_unpacklo_epi32(v2v3, color4));
+		o += 2;
+	}
+}
+#endif
+
+void pack_rectangles(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color,
+	std::vector< PongMode::CompactVertex > *out_) {
+	assert(out_);
+	auto &out = *out_;
+	size_t first = out.size();
+	out.resize(first + 4 * size_t(count), PongMode::CompactVertex(glm::vec2(0.0f), color));
+
+#ifdef CPU_X86_KERNELS
+	if (kernel_isa >= ISA::SSE2) {
+		pack_compact_sse2(centers, count, radius, color, out.data() + first);
+		return;
+	}
+#endif
+	pack_compact_scalar(centers, count, radius, color, out.data() + first);
+}
+
+void pack_rectangles(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color,
+	std::vector< PongMode::Vertex > *out_) {
+	assert(out_);
+	auto &out = *out_;
+	size_t first = out.size();
+	out.resize(first + 4 * size_t(count), PongMode::Vertex(glm::vec2(0.0f), color));
+
+#ifdef CPU_X86_KERNELS
+	if (kernel_isa >= ISA::SSE2) {
+		pack_sse2(centers, count, radius, color, out.data() + first);
+		return;
+	}
+#endif
+	pack_scalar(centers, count, radius, color, out.data() + first);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "PongMode.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+//Bulk loops from PongMode, with a version per instruction set (dispatched on kernel_isa, see cpu.hpp).
+//Every version gives bit-identical results (same operations in the same order, no fused multiply-add),
+// so replays and snapshots don't depend on the machine.
+
+//positions[i] += scale * velocities[i] for 'count' balls:
+void integrate_balls(glm::vec2 *positions, glm::vec2 const *velocities, uint32_t count, float scale);
+
+//append a quad (the same four vertices as PongMode::draw's draw_rectangle) for each of
+// 'count' rectangles of size 'radius' around 'centers', all in 'color', to 'out':
+void pack_rectangles(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color,
+	std::vector< PongMode::Vertex > *out);
+//...same, as compact vertices (quantized exactly as CompactVertex::quantize does):
+void pack_rectangles(glm::vec2 const *centers, uint32_t count, glm::vec2 const &radius, glm::u8vec4 const &color,
+	std::vector< PongMode::CompactVertex > *out);
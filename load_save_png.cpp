@@ -7,7 +7,7 @@
 #include <cassert>
 #include <vector>
 
-#define LOG_ERROR( X ) std::cerr << X << std::endl
+#include "log.hpp"
 
 using std::vector;
 
@@ -108,6 +108,7 @@ bool load_png(std::istream &from, unsigned int *width, unsigned int *height, vec
 	size_t rowbytes = png_get_rowbytes(png, info);
 	//Make sure it's the format we think it is...
 	assert(rowbytes == w*sizeof(uint32_t));
+	(void)rowbytes; //(only checked by the assert)
 
 	data->resize(w*h);
 	row_pointers = new png_bytep[h];
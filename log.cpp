@@ -0,0 +1,202 @@
+#include "log.hpp"
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//one queued message:
+struct LogRecord {
+	uint64_t ns;
+	LogLevel level;
+	uint32_t suppressed;
+	uint32_t length;
+	char text[496];
+};
+
+//per-thread ring of records (one writer, read by whoever holds drain_mutex):
+struct LogRing {
+	static constexpr uint32_t Size = 256; //must be a power of two
+	std::array< LogRecord, Size > records;
+	std::atomic< uint32_t > head{0}; //next slot to write
+	std::atomic< uint32_t > tail{0}; //next slot to read
+	std::atomic< uint32_t > dropped{0}; //records lost because the ring was full
+	//formatting scratch space (owning thread only), one stream per LogLine alive on the thread,
+	// so a message that logs while it is being formatted doesn't write into the outer one:
+	std::vector< std::unique_ptr< std::ostringstream > > streams;
+	uint32_t depth = 0; //streams in use
+};
+
+struct LogState {
+	LogState() {
+		thread = std::thread(&LogState::run, this);
+	}
+	~LogState() {
+		{
+			std::lock_guard< std::mutex > lock(wake_mutex);
+			quit = true;
+		}
+		wake.notify_one();
+		thread.join();
+		drain();
+	}
+
+	LogRing &ring() {
+		static thread_local LogRing *thread_ring = nullptr;
+		if (!thread_ring) {
+			std::lock_guard< std::mutex > lock(rings_mutex);
+			rings.emplace_back(new LogRing);
+			thread_ring = rings.back().get();
+		}
+		return *thread_ring;
+	}
+
+	//write out every queued record, oldest first:
+	void drain() {
+		std::lock_guard< std::mutex > drain_lock(drain_mutex);
+		batch.clear();
+		heads.clear();
+		uint32_t dropped = 0;
+		{
+			std::lock_guard< std::mutex > lock(rings_mutex);
+			for (auto &r : rings) {
+				uint32_t t = r->tail.load(std::memory_order_relaxed);
+				uint32_t h = r->head.load(std::memory_order_acquire);
+				for (; t != h; ++t) {
+					batch.emplace_back(&r->records[t & (LogRing::Size - 1)]);
+				}
+				heads.emplace_back(h);
+				dropped += r->dropped.exchange(0, std::memory_order_relaxed);
+			}
+		}
+		std::stable_sort(batch.begin(), batch.end(), [](LogRecord const *a, LogRecord const *b) {
+			return a->ns < b->ns;
+		});
+		bool wrote_out = false;
+		bool wrote_err = false;
+		for (LogRecord const *rec : batch) {
+			std::ostream &to = (rec->level >= LogWarning ? std::cerr : std::cout);
+			if (rec->level == LogDebug) to << "DEBUG: ";
+			if (rec->level == LogWarning) to << "WARNING: ";
+			if (rec->level == LogError) to << "ERROR: ";
+			to.write(rec->text, rec->length);
+			if (rec->suppressed) to << " (" << rec->suppressed << " similar messages suppressed)";
+			to << '\n';
+			(rec->level >= LogWarning ? wrote_err : wrote_out) = true;
+		}
+		if (dropped) {
+			std::cerr << "WARNING: " << dropped << " log messages dropped (log buffer full).\n";
+			wrote_err = true;
+		}
+		if (wrote_out) std::cout.flush();
+		if (wrote_err) std::cerr.flush();
+
+		//release the slots only once the records have been written:
+		//(only up to the heads seen above -- anything pushed since waits for the next drain)
+		std::lock_guard< std::mutex > lock(rings_mutex);
+		for (size_t i = 0; i < heads.size(); ++i) {
+			rings[i]->tail.store(heads[i], std::memory_order_release);
+		}
+	}
+
+	void run() {
+		while (true) {
+			{
+				std::unique_lock< std::mutex > lock(wake_mutex);
+				wake.wait_for(lock, std::chrono::milliseconds(50), [this](){ return quit || urgent; });
+				if (quit) break;
+				urgent = false;
+			}
+			drain();
+		}
+	}
+
+	std::mutex rings_mutex; //guards 'rings'
+	std::vector< std::unique_ptr< LogRing > > rings;
+
+	std::mutex drain_mutex; //held while writing records out
+	std::vector< LogRecord const * > batch;
+	std::vector< uint32_t > heads; //head of each ring when 'batch' was collected
+
+	std::mutex wake_mutex;
+	std::condition_variable wake;
+	bool quit = false; //guarded by wake_mutex
+	bool urgent = false; //guarded by wake_mutex; an error is waiting
+	std::thread thread;
+};
+
+static LogState &log_state() {
+	static LogState state;
+	return state;
+}
+
+bool LogSite::allow() {
+	uint64_t now = Profiler::now_ns() / 1000000000ULL;
+	uint64_t was = second.load(std::memory_order_relaxed);
+	if (was != now && second.compare_exchange_strong(was, now, std::memory_order_relaxed)) {
+		in_second.store(0, std::memory_order_relaxed);
+	}
+	if (in_second.fetch_add(1, std::memory_order_relaxed) >= LOG_RATE_LIMIT) {
+		suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+static std::ostringstream &push_stream(LogRing &ring) {
+	if (ring.depth == ring.streams.size()) {
+		ring.streams.emplace_back(new std::ostringstream);
+	}
+	return *ring.streams[ring.depth++];
+}
+
+LogLine::LogLine(LogLevel level_, LogSite &site) : out(push_stream(log_state().ring())), level(level_) {
+	out.str(std::string());
+	out.clear();
+	suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+}
+
+LogLine::~LogLine() {
+	LogState &state = log_state();
+	LogRing &ring = state.ring();
+	//(any LogLine made while this one was formatting is already gone, so this was the top stream)
+	ring.depth -= 1;
+
+	uint32_t h = ring.head.load(std::memory_order_relaxed);
+	if (h - ring.tail.load(std::memory_order_acquire) >= LogRing::Size) {
+		//flusher is behind; drop rather than block:
+		ring.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	LogRecord &rec = ring.records[h & (LogRing::Size - 1)];
+	rec.ns = Profiler::now_ns();
+	rec.level = level;
+	rec.suppressed = suppressed;
+	std::string const &text = out.str();
+	rec.length = uint32_t(std::min(text.size(), sizeof(rec.text)));
+	std::memcpy(rec.text, text.data(), rec.length);
+	if (text.size() > sizeof(rec.text)) {
+		std::memcpy(rec.text + sizeof(rec.text) - 3, "...", 3);
+	}
+	ring.head.store(h + 1, std::memory_order_release);
+
+	if (level >= LogError) {
+		{
+			std::lock_guard< std::mutex > lock(state.wake_mutex);
+			state.urgent = true;
+		}
+		state.wake.notify_one();
+	}
+}
+
+void log_flush() {
+	log_state().drain();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+
+/*
+ * Buffered, leveled logging:
+ *
+ *   LOG_INFO("Loaded " << count << " balls.");
+ *   LOG_WARNING("gl error at " << where);
+ *
+ * Messages below LOG_MIN_LEVEL compile to nothing. Others are formatted on
+ *  the calling thread into that thread's ring buffer (no locks) and written
+ *  out by a background thread, so logging never waits on the console.
+ * Each call site prints at most LOG_RATE_LIMIT messages per second; the
+ *  number of messages dropped by the limit is reported with the next one.
+ *
+ * Debug and info go to stdout, warnings and errors to stderr.
+ */
+
+enum LogLevel : uint8_t {
+	LogDebug = 0,
+	LogInfo = 1,
+	LogWarning = 2,
+	LogError = 3,
+};
+
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL LogInfo
+#else
+#define LOG_MIN_LEVEL LogDebug
+#endif
+#endif
+
+#ifndef LOG_RATE_LIMIT
+#define LOG_RATE_LIMIT 10
+#endif
+
+//per-call-site rate limiting state:
+struct LogSite {
+	std::atomic< uint64_t > second{0}; //current one-second window
+	std::atomic< uint32_t > in_second{0}; //messages seen in that window
+	std::atomic< uint32_t > suppressed{0}; //messages dropped since the last one printed
+
+	//true if a message from this site should be printed now:
+	bool allow();
+};
+
+//formats one message and queues it when it goes out of scope:
+struct LogLine {
+	LogLine(LogLevel level, LogSite &site);
+	~LogLine();
+	LogLine(LogLine const &) = delete;
+	LogLine &operator=(LogLine const &) = delete;
+
+	std::ostringstream &out; //(one per LogLine alive on this thread, so LOG_* calls made while formatting get their own)
+	LogLevel level;
+	uint32_t suppressed;
+};
+
+//write out everything queued so far (call before exiting or writing to the console directly):
+void log_flush();
+
+#define LOG_AT(LEVEL, MSG) \
+	do { \
+		if ((LEVEL) >= LOG_MIN_LEVEL) { \
+			static LogSite log_site_; \
+			if (log_site_.allow()) { \
+				LogLine log_line_(LEVEL, log_site_); \
+				log_line_.out << MSG; \
+			} \
+		} \
+	} while (0)
+
+#define LOG_DEBUG(MSG) LOG_AT(LogDebug, MSG)
+#define LOG_INFO(MSG) LOG_AT(LogInfo, MSG)
+#define LOG_WARNING(MSG) LOG_AT(LogWarning, MSG)
+#define LOG_ERROR(MSG) LOG_AT(LogError, MSG)
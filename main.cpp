@@ -1,15 +1,53 @@
-//Mode.hpp declares the "Mode::current" static member variable, which is used to decide where event-handling, updating, and drawing events go:
+//Mode.hpp declares the mode stack ("Mode::current" is its top), which is used to decide where event-handling, updating, and drawing events go:
 #include "Mode.hpp"
 
 //The 'PongMode' mode plays the game:
 #include "PongMode.hpp"
 
+//...and 'ProfilerOverlayMode' draws frame timings over it:
+#include "ProfilerOverlayMode.hpp"
+
+//GL objects shared by modes:
+#include "Renderer.hpp"
+
 //GL.hpp will include a non-namespace-polluting set of opengl prototypes:
 #include "GL.hpp"
 
 //for screenshots:
 #include "load_save_png.hpp"
 
+//GL error reporting:
+#include "gl_errors.hpp"
+
+//optional GL fast paths:
+#include "gl_caps.hpp"
+#include "gl_compile_program.hpp"
+
+//frame timing:
+#include "Profiler.hpp"
+#include "TraceWriter.hpp"
+
+//input recording and playback:
+#include "Replay.hpp"
+
+//micro-benchmarks:
+#include "bench.hpp"
+
+//vsync / frame rate cap and input latency:
+#include "FramePacer.hpp"
+
+//rendering without a visible window:
+#include "OffscreenTarget.hpp"
+
+//render regression checks:
+#include "golden.hpp"
+
+//instruction set for the vectorized kernels:
+#include "cpu.hpp"
+
+//console output:
+#include "log.hpp"
+
 //Includes for libSDL:
 #include <SDL.h>
 
@@ -19,6 +57,21 @@
 #include <stdexcept>
 #include <memory>
 #include <algorithm>
+#include <string>
+#include <cstdlib>
+#include <fstream>
+#include <cerrno>
+
+//parse all of 'str' as a decimal uint32_t; false (leaving 'value' alone) if it isn't one:
+static bool parse_uint32(char const *str, uint32_t *value) {
+	if (str[0] < '0' || str[0] > '9') return false; //(strtoul would skip spaces and accept a sign)
+	char *end = nullptr;
+	errno = 0;
+	unsigned long parsed = std::strtoul(str, &end, 10);
+	if (*end != '\0' || errno == ERANGE || parsed > 0xffffffffUL) return false;
+	*value = uint32_t(parsed);
+	return true;
+}
 
 int main(int argc, char **argv) {
 #ifdef _WIN32
@@ -26,12 +79,185 @@ int main(int argc, char **argv) {
 	try {
 #endif
 
+	//------------  command line ------------
+
+	std::string profile_csv; //if set, per-frame zone timings are written here on exit
+	std::string trace_json; //if set, zones are streamed here as chrome trace events
+
+	std::string record_file; //if set, a replay of this session is written here on exit
+	std::string play_file; //if set, input comes from this replay instead of the mouse and clock
+	bool headless = false; //hidden window, no vsync; plays play_file or a synthetic workload
+	uint32_t headless_frames = 3600; //length of the synthetic workload
+	uint32_t seed = std::mt19937::default_seed; //PongMode's random seed (replays carry their own)
+	std::string snapshot_file = "snapshot.pong"; //F5 saves here, F9 (or --snapshot) loads
+	bool load_snapshot = false;
+	bool event_sim = false; //use PongMode's event-driven collision scheduling
+	bool compact_vertices = false; //draw with PongMode's compact vertex format
+	std::string pacing; //FramePacer mode (default: adaptive, or uncapped when headless)
+	bool late_mouse = true; //re-read the mouse just before drawing (see PongMode::late_mouse)
+	bool run_bench_paddles = false;
+	glm::uvec2 offscreen_size = glm::uvec2(0); //if nonzero, render into a framebuffer of this size instead of the (hidden) window
+	bool render_bench = false; //print per-frame CPU / GPU times at the end of an offscreen run
+	std::string golden_dir; //if set, compare fixed scenes against the golden images here (see golden.hpp) instead of playing
+	bool golden_update = false; //...or write new golden images
+	bool golden_check = false; //check the SIMD image diff against the scalar one and exit
+	std::string isa; //force the vectorized kernels to an instruction set (default: best available)
+
+	//tracing can also be turned on from the environment:
+	if (char const *env = std::getenv("PONG_TRACE")) {
+		trace_json = env;
+	}
+
+	auto usage = [&]() {
+		std::cerr << "Usage:\n\t" << argv[0] << "\n"
+			"\t\t[--profile-csv <file.csv>] [--trace <file.json>]\n"
+			"\t\t[--record <file.replay>] [--play <file.replay>] [--seed <n>]\n"
+			"\t\t[--headless [--frames <n>]] [--snapshot <file.pong>] [--event-sim] [--compact-vertices]\n"
+			"\t\t[--pacing vsync|adaptive|cap:<hz>|uncapped] [--no-late-mouse]\n"
+			"\t\t[--offscreen <w>x<h>] [--render-bench] [--golden <dir> [--golden-update]] [--golden-selftest]\n"
+			"\t\t[--bench-paddles] [--isa scalar|sse2|avx2|avx512]" << std::endl;
+	};
+
+	for (int argi = 1; argi < argc; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--profile-csv" && argi + 1 < argc) {
+			profile_csv = argv[++argi];
+		} else if (arg == "--trace" && argi + 1 < argc) {
+			trace_json = argv[++argi];
+		} else if (arg == "--record" && argi + 1 < argc) {
+			record_file = argv[++argi];
+		} else if (arg == "--play" && argi + 1 < argc) {
+			play_file = argv[++argi];
+		} else if (arg == "--headless") {
+			headless = true;
+		} else if (arg == "--frames" && argi + 1 < argc) {
+			if (!parse_uint32(argv[++argi], &headless_frames)) {
+				std::cerr << "Expected a number after --frames, got '" << argv[argi] << "'." << std::endl;
+				usage();
+				return 1;
+			}
+		} else if (arg == "--seed" && argi + 1 < argc) {
+			if (!parse_uint32(argv[++argi], &seed)) {
+				std::cerr << "Expected a number after --seed, got '" << argv[argi] << "'." << std::endl;
+				usage();
+				return 1;
+			}
+		} else if (arg == "--snapshot" && argi + 1 < argc) {
+			snapshot_file = argv[++argi];
+			load_snapshot = true;
+		} else if (arg == "--event-sim") {
+			event_sim = true;
+		} else if (arg == "--compact-vertices") {
+			compact_vertices = true;
+		} else if (arg == "--offscreen" && argi + 1 < argc) {
+			std::string size = argv[++argi];
+			auto x = size.find('x');
+			uint32_t width = 0, height = 0;
+			if (x == std::string::npos
+			 || !parse_uint32(size.substr(0, x).c_str(), &width) || !parse_uint32(size.substr(x + 1).c_str(), &height)
+			 || width == 0 || height == 0) {
+				std::cerr << "Expected --offscreen <width>x<height> (both nonzero), got '" << size << "'." << std::endl;
+				usage();
+				return 1;
+			}
+			offscreen_size = glm::uvec2(width, height);
+			headless = true;
+		} else if (arg == "--render-bench") {
+			render_bench = true;
+			headless = true;
+		} else if (arg == "--no-late-mouse") {
+			late_mouse = false;
+		} else if (arg == "--pacing" && argi + 1 < argc) {
+			pacing = argv[++argi];
+		} else if (arg == "--golden" && argi + 1 < argc) {
+			golden_dir = argv[++argi];
+			headless = true;
+		} else if (arg == "--golden-update") {
+			golden_update = true;
+		} else if (arg == "--golden-selftest") {
+			golden_check = true;
+		} else if (arg == "--bench-paddles") {
+			run_bench_paddles = true;
+		} else if (arg == "--isa" && argi + 1 < argc) {
+			isa = argv[++argi];
+		} else {
+			std::cerr << "Unrecognized argument '" << arg << "'." << std::endl;
+			usage();
+			return 1;
+		}
+	}
+
+	if (!isa.empty() && !set_kernel_isa(isa)) {
+		std::cerr << "Can't use '" << isa << "' kernels (best available is '" << isa_name(best_isa()) << "')." << std::endl;
+		return 1;
+	}
+	LOG_INFO("Kernels: " << isa_name(kernel_isa) << (isa.empty() ? " (best available)." : " (forced with --isa)."));
+
+	if (render_bench && offscreen_size == glm::uvec2(0)) {
+		offscreen_size = glm::uvec2(1280, 720);
+	}
+	FramePacer pacer;
+	FramePacer::Mode pacing_mode = (headless ? FramePacer::Mode::Uncapped : FramePacer::Mode::Adaptive);
+	float pacing_hz = 0.0f;
+	if (!pacing.empty() && !FramePacer::parse(pacing, &pacing_mode, &pacing_hz)) {
+		std::cerr << "Unknown pacing mode '" << pacing << "' (expected vsync, adaptive, cap:<hz>, or uncapped)." << std::endl;
+		return 1;
+	}
+
+	if (golden_update && golden_dir.empty()) {
+		std::cerr << "--golden-update needs --golden <dir>." << std::endl;
+		return 1;
+	}
+	bool offscreen = (offscreen_size != glm::uvec2(0) || !golden_dir.empty());
+
+	if (run_bench_paddles) {
+		log_flush();
+		bench_paddles();
+		return 0;
+	}
+
+	if (golden_check) {
+		log_flush();
+		return golden_selftest();
+	}
+
+	//playback replaces mouse input and the clock with recorded (or scripted) values:
+	Replay playback;
+	bool playing = false;
+	if (!play_file.empty()) {
+		playback = Replay::load(play_file);
+		playing = true;
+	} else if (headless) {
+		playback = Replay::synthetic(seed, headless_frames, 1.0f / 60.0f);
+		playing = true;
+	}
+	if (playing) seed = playback.seed;
+	uint32_t playback_frame = 0;
+
+	Replay recording;
+	recording.seed = seed;
+
+	profiler.keep_csv = !profile_csv.empty();
+
+	std::unique_ptr< TraceWriter > trace;
+	if (!trace_json.empty()) {
+		trace.reset(new TraceWriter(trace_json));
+		profiler.trace = trace.get();
+		LOG_INFO("Writing trace events to '" << trace_json << "'.");
+	}
+
 	//------------  initialization ------------
 
 	//Initialize SDL library:
-	SDL_Init(SDL_INIT_VIDEO);
+	if (SDL_Init(SDL_INIT_VIDEO) != 0 && offscreen) {
+		//no display (e.g., a GPU-less build machine)? SDL's "offscreen" driver makes EGL
+		// pbuffer contexts instead, which Mesa's llvmpipe can provide:
+		LOG_WARNING("SDL video init failed (" << SDL_GetError() << "); trying the offscreen driver.");
+		SDL_setenv("SDL_VIDEODRIVER", "offscreen", 1);
+		SDL_Init(SDL_INIT_VIDEO);
+	}
 
-	//Ask for an OpenGL context version 3.3, core profile, enable debug:
+	//Ask for an OpenGL context version 3.3, core profile, enable debug (in debug builds):
 	SDL_GL_ResetAttributes();
 	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
@@ -41,7 +267,9 @@ int main(int argc, char **argv) {
 	SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+#ifndef NDEBUG
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+#endif
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
@@ -53,13 +281,15 @@ int main(int argc, char **argv) {
 		SDL_WINDOW_OPENGL
 		| SDL_WINDOW_RESIZABLE //uncomment to allow resizing
 		| SDL_WINDOW_ALLOW_HIGHDPI //uncomment for full resolution on high-DPI screens
+		| (headless ? SDL_WINDOW_HIDDEN : 0)
 	);
 
 	//prevent exceedingly tiny windows when resizing:
 	SDL_SetWindowMinimumSize(window, 100, 100);
 
 	if (!window) {
-		std::cerr << "Error creating SDL window: " << SDL_GetError() << std::endl;
+		LOG_ERROR("Error creating SDL window: " << SDL_GetError());
+		log_flush();
 		return 1;
 	}
 
@@ -68,26 +298,101 @@ int main(int argc, char **argv) {
 
 	if (!context) {
 		SDL_DestroyWindow(window);
-		std::cerr << "Error creating OpenGL context: " << SDL_GetError() << std::endl;
+		LOG_ERROR("Error creating OpenGL context: " << SDL_GetError());
+		log_flush();
 		return 1;
 	}
 
 	//On windows, load OpenGL entrypoints: (does nothing on other platforms)
 	init_GL();
 
-	//Set VSYNC + Late Swap (prevents crazy FPS):
-	if (SDL_GL_SetSwapInterval(-1) != 0) {
-		std::cerr << "NOTE: couldn't set vsync + late swap tearing (" << SDL_GetError() << ")." << std::endl;
-		if (SDL_GL_SetSwapInterval(1) != 0) {
-			std::cerr << "NOTE: couldn't set vsync (" << SDL_GetError() << ")." << std::endl;
+	//Report GL errors through the debug output callback if there is one:
+	gl_debug_output_init();
+
+	//Pick the GL fast paths this driver allows (see gl_caps.hpp):
+	gl_caps_init();
+
+	//Keep linked shader programs between runs, in SDL's per-user data directory:
+	//(SDL_GetPrefPath creates the directory, so only ask for it when there's something to keep)
+	if (gl_caps.program_binaries) {
+		if (char *pref_path = SDL_GetPrefPath("15-466", "pong")) {
+			gl_program_cache_dir = pref_path;
+			SDL_free(pref_path);
 		}
 	}
 
+	//Set VSYNC + Late Swap (prevents crazy FPS), unless headless (as fast as possible) or --pacing says otherwise:
+	pacer.set(pacing_mode, pacing_hz);
+
+	//programs, textures, and buffers shared by every mode:
+	std::shared_ptr< Renderer > renderer = std::make_shared< Renderer >();
+
+	//golden image checks render their own fixed scenes (offscreen) and exit:
+	if (!golden_dir.empty()) {
+		log_flush();
+		int result = run_golden(golden_dir, golden_update, renderer);
+		log_flush();
+		renderer.reset();
+		SDL_GL_DeleteContext(context);
+		SDL_DestroyWindow(window);
+		return result;
+	}
+
+	//offscreen runs draw into a framebuffer of their own and never swap:
+	std::unique_ptr< OffscreenTarget > offscreen_target;
+	if (offscreen) {
+		offscreen_target.reset(new OffscreenTarget(offscreen_size));
+		LOG_INFO("Rendering offscreen at " << offscreen_size.x << "x" << offscreen_size.y << ".");
+	}
+
+	//don't queue event types nothing here looks at (touch, gestures, text input, game controllers, ...):
+	for (Uint32 type : {
+		Uint32(SDL_TEXTEDITING), Uint32(SDL_TEXTINPUT), Uint32(SDL_KEYMAPCHANGED),
+		Uint32(SDL_FINGERDOWN), Uint32(SDL_FINGERUP), Uint32(SDL_FINGERMOTION),
+		Uint32(SDL_DOLLARGESTURE), Uint32(SDL_DOLLARRECORD), Uint32(SDL_MULTIGESTURE),
+		Uint32(SDL_JOYAXISMOTION), Uint32(SDL_JOYBALLMOTION), Uint32(SDL_JOYHATMOTION),
+		Uint32(SDL_CONTROLLERAXISMOTION), Uint32(SDL_SENSORUPDATE),
+		Uint32(SDL_CLIPBOARDUPDATE), Uint32(SDL_AUDIODEVICEADDED), Uint32(SDL_AUDIODEVICEREMOVED),
+	}) {
+		SDL_EventState(type, SDL_IGNORE);
+	}
+
 	//Hide mouse cursor (note: showing can be useful for debugging):
 	//SDL_ShowCursor(SDL_DISABLE);
 
 	//------------ create game mode + make current --------------
-	Mode::set_current(std::make_shared< PongMode >());
+	std::shared_ptr< PongMode > pong = std::make_shared< PongMode >(seed, renderer);
+	if (load_snapshot) {
+		//start from a saved state (e.g., a heavy scene for benchmarking):
+		std::ifstream from(snapshot_file, std::ios::binary);
+		if (!from) throw std::runtime_error("Failed to open snapshot '" + snapshot_file + "'.");
+		pong->load_snapshot(from);
+	}
+	//(command-line settings, reapplied to each new game):
+	auto configure = [&](PongMode &game) {
+		game.event_driven = event_sim;
+		game.compact_vertices = compact_vertices;
+		game.late_mouse = late_mouse && !playing;
+	};
+	configure(*pong);
+	Mode::set_current(pong);
+
+	//the next game (F2) is built on a loading thread ahead of time, so starting it costs nothing;
+	// replays are a single game from a single seed, so there is no next game then:
+	uint32_t next_seed = seed;
+	Mode::Preloaded< PongMode > next_game;
+	auto preload_next_game = [&]() {
+		if (playing || !record_file.empty()) return;
+		next_seed += 1;
+		uint32_t game_seed = next_seed;
+		next_game = Mode::preload< PongMode >([game_seed, renderer]() {
+			return std::make_shared< PongMode >(game_seed, renderer);
+		});
+	};
+	preload_next_game();
+
+	//profiler overlay (F1), pushed over the game while shown:
+	std::shared_ptr< ProfilerOverlayMode > profiler_overlay = std::make_shared< ProfilerOverlayMode >(renderer);
 
 	//------------ main loop ------------
 
@@ -100,46 +405,144 @@ int main(int argc, char **argv) {
 		int w,h;
 		SDL_GetWindowSize(window, &w, &h);
 		window_size = glm::uvec2(w, h);
+		if (offscreen_target) {
+			drawable_size = offscreen_target->size;
+			offscreen_target->bind();
+			return;
+		}
 		SDL_GL_GetDrawableSize(window, &w, &h);
 		drawable_size = glm::uvec2(w, h);
 		glViewport(0, 0, drawable_size.x, drawable_size.y);
 	};
 	on_resize();
 
+	RenderBench bench;
+	auto bench_start = std::chrono::steady_clock::now();
+
 	//This will loop until the current mode is set to null:
 	while (Mode::current) {
 		//every pass through the game loop creates one frame of output
 		//  by performing three steps:
 
+		//(0) in cap mode, hold the frame's start until its time slot (before reading input, to keep latency down):
+		pacer.wait();
+
 		{ //(1) process any events that are pending
-			static SDL_Event evt;
-			while (SDL_PollEvent(&evt) == 1) {
-				//handle resizing:
-				if (evt.type == SDL_WINDOWEVENT && evt.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
-					on_resize();
-				}
-				//handle input:
-				if (Mode::current && Mode::current->handle_event(evt, window_size)) {
-					// mode handled it; great
-				} else if (evt.type == SDL_QUIT) {
-					Mode::set_current(nullptr);
-					break;
-				} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_PRINTSCREEN) {
-					// --- screenshot key ---
-					std::string filename = "screenshot.png";
-					std::cout << "Saving screenshot to '" << filename << "'." << std::endl;
-					glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-					glReadBuffer(GL_FRONT);
-					int w,h;
-					SDL_GL_GetDrawableSize(window, &w, &h);
-					std::vector< glm::u8vec4 > data(w*h);
-					glReadPixels(0,0,w,h, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
-					for (auto &px : data) {
-						px.a = 0xff;
+			PROFILE_ZONE("events");
+			//take events from SDL's queue a batch at a time (rather than one SDL_PollEvent call each):
+			static SDL_Event events[64];
+			uint32_t processed = 0, coalesced = 0;
+			SDL_PumpEvents();
+			int got;
+			while (Mode::current && (got = SDL_PeepEvents(events, 64, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT)) > 0) {
+				for (int ei = 0; ei < got; ++ei) {
+					SDL_Event const &evt = events[ei];
+					//handle resizing:
+					if (evt.type == SDL_WINDOWEVENT && evt.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+						on_resize();
+					}
+					//during playback the paddle comes from the replay, not the mouse:
+					if (playing && evt.type == SDL_MOUSEMOTION) continue;
+					//start the input-to-swap clock:
+					if (evt.type == SDL_MOUSEMOTION || evt.type == SDL_MOUSEBUTTONDOWN || evt.type == SDL_KEYDOWN) {
+						pacer.input();
+					}
+					//of a run of motion events, only the last position matters (modes don't use xrel/yrel):
+					if (evt.type == SDL_MOUSEMOTION && ei + 1 < got && events[ei + 1].type == SDL_MOUSEMOTION) {
+						++coalesced;
+						continue;
+					}
+					++processed;
+					//handle input:
+					if (Mode::stack_handle_event(evt, window_size)) {
+						// mode handled it; great
+					} else if (evt.type == SDL_QUIT) {
+						Mode::set_current(nullptr);
+						break;
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F1) {
+						// --- profiler overlay key ---
+						profiler.show_overlay = !profiler.show_overlay;
+						if (!profiler.show_overlay && Mode::current == profiler_overlay) Mode::pop();
+						if (profiler.show_overlay) {
+							Mode::push(profiler_overlay, true);
+							//overlay has no text, so print which bar is which:
+							std::string legend = "Profiler overlay rows (top to bottom):";
+							for (auto const &z : profiler.zones) {
+								legend += "\n  " + std::string(2 * z.depth, ' ') + z.name;
+							}
+							LOG_INFO(legend);
+						}
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F2) {
+						// --- new game key ---
+						if (!next_game.valid()) {
+							LOG_WARNING("New game is not available during replay playback or recording.");
+						} else {
+							if (!next_game.ready()) LOG_INFO("Waiting for the next game to finish loading...");
+							//keep the current settings (which may have been toggled since startup):
+							bool event_driven = pong->event_driven;
+							bool compact = pong->compact_vertices;
+							pong = next_game.take();
+							configure(*pong);
+							pong->event_driven = event_driven;
+							pong->compact_vertices = compact;
+							Mode::set_current(pong);
+							if (profiler.show_overlay) Mode::push(profiler_overlay, true);
+							LOG_INFO("New game (seed " << next_seed << ").");
+							preload_next_game();
+						}
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F4) {
+						// --- collision scheduling key ---
+						pong->event_driven = !pong->event_driven;
+						pong->scheduler.invalidate();
+						LOG_INFO("Collision handling: " << (pong->event_driven ? "event-driven" : "stepped") << ".");
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F6) {
+						// --- vertex format key ---
+						pong->compact_vertices = !pong->compact_vertices;
+						LOG_INFO("Vertex format: " << (pong->compact_vertices ? "compact (8 bytes)" : "full (24 bytes)") << ".");
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F7) {
+						// --- frame pacing key ---
+						pacer.cycle();
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F5) {
+						// --- save snapshot key ---
+						try {
+							std::ofstream to(snapshot_file, std::ios::binary);
+							if (!to) throw std::runtime_error("couldn't open it for writing");
+							pong->save_snapshot(to);
+							to.flush();
+							if (!to) throw std::runtime_error("writing failed");
+							LOG_INFO("Saved snapshot (" << pong->balls.size() << " balls) to '" << snapshot_file << "'.");
+						} catch (std::exception const &e) {
+							LOG_ERROR("Failed to save snapshot '" << snapshot_file << "': " << e.what());
+						}
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_F9) {
+						// --- load snapshot key ---
+						try {
+							std::ifstream from(snapshot_file, std::ios::binary);
+							pong->load_snapshot(from);
+							LOG_INFO("Loaded snapshot (" << pong->balls.size() << " balls) from '" << snapshot_file << "'.");
+						} catch (std::exception const &e) {
+							LOG_ERROR("Failed to load snapshot '" << snapshot_file << "': " << e.what());
+						}
+					} else if (evt.type == SDL_KEYDOWN && evt.key.keysym.sym == SDLK_PRINTSCREEN) {
+						// --- screenshot key ---
+						PROFILE_ZONE("screenshot");
+						std::string filename = "screenshot.png";
+						LOG_INFO("Saving screenshot to '" << filename << "'.");
+						glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+						glReadBuffer(GL_FRONT);
+						int w,h;
+						SDL_GL_GetDrawableSize(window, &w, &h);
+						std::vector< glm::u8vec4 > data(w*h);
+						glReadPixels(0,0,w,h, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+						for (auto &px : data) {
+							px.a = 0xff;
+						}
+						save_png(filename, glm::uvec2(w,h), data.data(), LowerLeftOrigin);
 					}
-					save_png(filename, glm::uvec2(w,h), data.data(), LowerLeftOrigin);
 				}
 			}
+			profiler.count("events.processed", processed);
+			profiler.count("events.coalesced", coalesced);
 			if (!Mode::current) break;
 		}
 
@@ -153,22 +556,94 @@ int main(int argc, char **argv) {
 			//lag to avoid spiral of death:
 			elapsed = std::min(0.1f, elapsed);
 
-			Mode::current->update(elapsed);
+			if (playing) {
+				if (playback_frame >= playback.frames.size()) {
+					Mode::set_current(nullptr);
+					break;
+				}
+				Replay::Frame const &frame = playback.frames[playback_frame++];
+				elapsed = frame.elapsed;
+				pong->left_paddle.y = frame.left_paddle_y;
+			} else {
+				pong->apply_mouse(); //this frame's (coalesced) mouse motion
+			}
+			if (!record_file.empty()) {
+				recording.frames.emplace_back(Replay::Frame{elapsed, pong->left_paddle.y});
+			}
+
+			PROFILE_ZONE("update");
+			Mode::stack_update(elapsed);
 			if (!Mode::current) break;
 		}
 
-		{ //(3) call the current mode's "draw" function to produce output:
-		
-			Mode::current->draw(drawable_size);
+		{ //(3) call the visible modes' "draw" functions to produce output:
+			PROFILE_ZONE("draw");
+			renderer->begin_frame();
+			Mode::stack_draw(drawable_size);
+			renderer->flush(); //(everything the modes submitted, in one upload)
+			//the paddle was drawn from a late mouse read, so latency counts from then:
+			if (pong->late_mouse_counter) {
+				pacer.input_sampled(pong->late_mouse_counter);
+				pong->late_mouse_counter = 0;
+			}
+		}
+
+		{ //Wait until the recently-drawn frame is shown before doing it all again:
+			PROFILE_ZONE("swap");
+			if (offscreen_target) glFlush(); //(nothing to show; just hand the frame to the GPU)
+			else pacer.swap(window);
 		}
 
-		//Wait until the recently-drawn frame is shown before doing it all again:
-		SDL_GL_SwapWindow(window);
+		profiler.end_frame();
+		if (render_bench) bench.frame();
+	}
+
+	if (render_bench) {
+		glFinish(); //count the GPU work still in flight
+		double seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - bench_start).count();
+		log_flush();
+		bench.print(std::to_string(offscreen_size.x) + "x" + std::to_string(offscreen_size.y)
+			+ ", " + (compact_vertices ? "compact" : "full") + " vertices", seconds);
 	}
 
 
 	//------------  teardown ------------
 
+	log_flush(); //so queued messages come out before the summary below
+
+	if (playing) {
+		//summary (the state hash makes it easy to check that two runs really did the same work):
+		uint32_t hash = 2166136261u; //FNV-1a over final ball positions
+		for (auto const &ball : pong->balls) {
+			uint8_t const *bytes = reinterpret_cast< uint8_t const * >(&ball);
+			for (uint32_t i = 0; i < sizeof(ball); ++i) {
+				hash = (hash ^ bytes[i]) * 16777619u;
+			}
+		}
+		std::cout << "Played " << playback_frame << " frames; "
+			<< pong->balls.size() << " balls, score " << pong->left_score << "-" << pong->right_score
+			<< ", state hash " << std::hex << hash << std::dec << "." << std::endl;
+	}
+	pong.reset();
+	profiler_overlay.reset();
+	next_game = Mode::Preloaded< PongMode >(); //(waits for it if it's still loading)
+	offscreen_target.reset();
+	renderer.reset();
+
+	profiler.print_counters(std::cout);
+
+	if (!record_file.empty()) {
+		recording.save(record_file);
+		LOG_INFO("Wrote " << recording.frames.size() << " frames of replay to '" << record_file << "'.");
+	}
+
+	if (!profile_csv.empty()) {
+		profiler.write_csv(profile_csv);
+	}
+
+	profiler.trace = nullptr;
+	trace.reset(); //flushes and closes the trace file
+
 	SDL_GL_DeleteContext(context);
 	context = 0;
 
@@ -9,12 +9,73 @@ filtered = []
 lookups = []
 fps = []
 
+#dispatch table entries (see GL.hpp): (return type, name, arguments)
+core_functions = []
+
+#per-frame draw / bind / upload / query calls -- first in the dispatch table, so they share a few cache lines:
+HOT = [
+	"glDrawElementsBaseVertex", "glDrawElements", "glDrawArrays",
+	"glUseProgram", "glBindVertexArray", "glBindBuffer", "glBindTexture", "glActiveTexture",
+	"glBufferData", "glBufferSubData", "glUniformMatrix4fv",
+	"glEnable", "glDisable", "glBlendFunc", "glClearColor", "glClear", "glViewport",
+	"glBeginQuery", "glEndQuery", "glGetQueryObjectuiv", "glGetQueryObjectui64v",
+	"glGetError", "glBindFramebuffer",
+]
+
+#extensions beyond core 3.3 that init_GL() looks for.
+#Promoted extensions (ARB_*, most KHR_*) are empty in glcorearb.h -- their functions and tokens are listed
+# under the core version that absorbed them -- so each entry names what it provides:
+# (extension, functions, token name patterns, types)
+EXTENSIONS = [
+	("GL_ARB_buffer_storage",
+		["glBufferStorage"],
+		[r"GL_MAP_PERSISTENT_BIT", r"GL_MAP_COHERENT_BIT", r"GL_DYNAMIC_STORAGE_BIT", r"GL_CLIENT_STORAGE_BIT",
+		 r"GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT", r"GL_BUFFER_IMMUTABLE_STORAGE", r"GL_BUFFER_STORAGE_FLAGS"],
+		[]),
+	("GL_KHR_debug",
+		["glDebugMessageControl", "glDebugMessageInsert", "glDebugMessageCallback", "glGetDebugMessageLog",
+		 "glPushDebugGroup", "glPopDebugGroup", "glObjectLabel", "glGetObjectLabel", "glObjectPtrLabel", "glGetObjectPtrLabel"],
+		[r"GL_DEBUG_\w+", r"GL_MAX_DEBUG_\w+", r"GL_MAX_LABEL_LENGTH", r"GL_CONTEXT_FLAG_DEBUG_BIT",
+		 r"GL_STACK_OVERFLOW", r"GL_STACK_UNDERFLOW"],
+		["GLDEBUGPROC"]),
+	("GL_KHR_parallel_shader_compile",
+		["glMaxShaderCompilerThreadsKHR"],
+		[r"GL_MAX_SHADER_COMPILER_THREADS_KHR", r"GL_COMPLETION_STATUS_KHR"],
+		[]),
+	("GL_ARB_get_program_binary",
+		["glGetProgramBinary", "glProgramBinary", "glProgramParameteri"],
+		[r"GL_PROGRAM_BINARY_\w+", r"GL_NUM_PROGRAM_BINARY_FORMATS"],
+		[]),
+	("GL_ARB_draw_indirect",
+		["glDrawArraysIndirect", "glDrawElementsIndirect"],
+		[r"GL_DRAW_INDIRECT_BUFFER\w*"],
+		[]),
+	("GL_ARB_multi_draw_indirect", #(draws from GL_DRAW_INDIRECT_BUFFER, so it needs ARB_draw_indirect too)
+		["glMultiDrawArraysIndirect", "glMultiDrawElementsIndirect"],
+		[],
+		[]),
+]
+
+#everything in glcorearb.h, for looking up extension pieces:
+all_defines = {} #name -> line
+all_prototypes = {} #name -> (return type, arguments)
+all_typedefs = {} #name -> line
+
 with open('glcorearb.h', 'r') as f:
 	in_version = None
 	in_notice = False
 	did_notice = False
 	for line in f:
 		line = line.strip()
+		m = re.match(r"^#define (GL_\w+)\s+\S+$", line)
+		if m != None and m.group(1) not in all_defines:
+			all_defines[m.group(1)] = line
+		m = re.match(r"GLAPI(.*)APIENTRY ([^\s]+) (.*)$", line)
+		if m != None:
+			all_prototypes[m.group(2)] = (m.group(1), m.group(3))
+		m = re.match(r"^typedef [^(]*\(APIENTRY\s*\*(\w+)\)", line)
+		if m != None:
+			all_typedefs[m.group(1)] = line
 		if line == "/*" and not did_notice:
 			filtered.append(line)
 			in_notice = True
@@ -76,6 +137,8 @@ with open('glcorearb.h', 'r') as f:
 			#check for function prototype lines:
 			m = re.match(r"GLAPI(.*)APIENTRY ([^\s]+) (.*)$", line)
 			if m != None:
+				if mode != "skip":
+					core_functions.append((m.group(1), m.group(2), m.group(3), mode == "all_proto"))
 				if mode == "all_proto":
 					filtered.append(line)
 				elif mode == "win_pointer":
@@ -104,21 +167,70 @@ with open('glcorearb.h', 'r') as f:
 
 
 
+#---- extension pieces ----
+core_names = set(fn for (rt, fn, ag, proto) in core_functions)
+core_defines = set(re.match(r"^#define (\w+)", line).group(1) for line in filtered if line.startswith("#define"))
+
+ext_lines = [] #tokens + types
+ext_functions = [] #(extension, return type, name, arguments)
+for (ext, functions, tokens, types) in EXTENSIONS:
+	assert ext.startswith("GL_")
+	ext_lines.append("\n// " + ext + ":")
+	ext_lines.append("#define " + ext + " 1")
+	for ty in types:
+		assert ty in all_typedefs, "no typedef for " + ty
+		ext_lines.append(all_typedefs[ty])
+	for pattern in tokens:
+		#(vendor-suffixed duplicates -- GL_DEBUG_OUTPUT_ARB and so on -- only if the pattern asks for the suffix)
+		names = sorted(name for name in all_defines if re.fullmatch(pattern, name)
+			and not any(name.endswith(suffix) and not pattern.endswith(suffix) for suffix in ["_ARB", "_AMD", "_KHR", "_EXT", "_NV"]))
+		assert len(names) > 0, "no tokens match " + pattern
+		for name in names:
+			if name in core_defines: continue
+			core_defines.add(name)
+			ext_lines.append(all_defines[name])
+	for fn in functions:
+		assert fn in all_prototypes, "no prototype for " + fn
+		assert fn not in core_names
+		rt, ag = all_prototypes[fn]
+		ext_functions.append((ext, rt, fn, ag))
+
+hot = [fn for fn in HOT]
+for fn in hot:
+	assert fn in core_names, "hot function " + fn + " isn't in core 3.3"
+cold = [(rt, fn, ag) for (rt, fn, ag, proto) in core_functions if fn not in hot]
+by_name = dict((fn, (rt, ag)) for (rt, fn, ag, proto) in core_functions)
+
+def member(rt, fn, ag):
+	return "\t" + rt.strip() + " (APIENTRYP " + fn + ") " + ag
+
 with open("GL.hpp", "w") as f:
 	print("""#pragma once
 
 /*
  *
- * Function prototypes/pointers for OpenGL 3.3 core, with minimal namespace pollution.
+ * Function prototypes/pointers for OpenGL 3.3 core, plus a few extensions,
+ *  with minimal namespace pollution.
  * Call init_GL() after you have created a context.
  *
- * On Windows, OpenGL 1.0 & 1.1 are prototypes, the rest are pointers
- *  initialized by init_GL(). This is because the 1.1/1.0 entries are
- *  the only ones provided directly by OpenGL32.dll 
+ * By default (GL_DISPATCH_TABLE), every entry point -- on every platform -- is
+ *  a function pointer in the gl_dispatch table, loaded by init_GL() through
+ *  SDL_GL_GetProcAddress; the gl* names are macros that call through it. The
+ *  calls used every frame come first in the table, so they share a few cache
+ *  lines.
  *
- * On Linux, all are prototypes.
+ * Building with GL_PROTOTYPES defined instead uses the old arrangement:
+ *  on Windows, OpenGL 1.0 & 1.1 are prototypes, the rest are pointers
+ *  initialized by init_GL() (because the 1.1/1.0 entries are the only ones
+ *  provided directly by OpenGL32.dll); on Linux and MacOS, all are prototypes.
  *
- * On MacOS, all are prototypes.
+ * Either way, extension functions (see the end of this file) are always
+ *  table entries, null unless the driver has them; check gl_extensions
+ *  (filled in once, by init_GL()) before calling them.
+ *
+ * NOTE: the table belongs to the context that was current for init_GL().
+ *  (Only Windows can hand out different pointers for different contexts;
+ *  call init_GL() again after switching to one made with other settings.)
  *
  * This file has been automatically generated from glcorearb.h by make-GL.py
  *
@@ -126,6 +238,10 @@ with open("GL.hpp", "w") as f:
 
 void init_GL(); //will throw on failure.
 
+#if !defined(GL_PROTOTYPES) && !defined(GL_DISPATCH_TABLE)
+#define GL_DISPATCH_TABLE 1
+#endif
+
 extern "C" {
 
 #include <stdint.h>
@@ -137,6 +253,7 @@ extern "C" {
 	#define APIENTRY
 	#define APIENTRYFP
 #endif
+#define APIENTRYP APIENTRY * //(dispatch table entries are always pointers)
 
 //this is how khronos_ssize_t gets defined in khrplatform.h:
 #ifdef _WIN64
@@ -150,8 +267,41 @@ typedef signed   long  int     khronos_ssize_t;
 
 	print("\n".join(filtered), file=f)
 
+	print("\n// ---- extensions ----", file=f)
+	print("\n".join(ext_lines), file=f)
+
 	print("""
-}""", file=f)
+}
+
+//---- dispatch table ----
+
+struct GLDispatch {""", file=f)
+	print("\t//per-frame calls:", file=f)
+	for fn in hot:
+		rt, ag = by_name[fn]
+		print(member(rt, fn, ag), file=f)
+	print("\n\t//the rest of core 3.3:", file=f)
+	for (rt, fn, ag) in cold:
+		print(member(rt, fn, ag), file=f)
+	print("\n\t//extensions (null if not available):", file=f)
+	for (ext, rt, fn, ag) in ext_functions:
+		print(member(rt, fn, ag), file=f)
+	print("""};
+extern GLDispatch gl_dispatch;
+
+//which extensions init_GL() found (and loaded every function of):
+struct GLExtensions {""", file=f)
+	for (ext, functions, tokens, types) in EXTENSIONS:
+		print("\tbool " + ext[3:] + " = false;", file=f)
+	print("""};
+extern GLExtensions gl_extensions;
+
+#ifdef GL_DISPATCH_TABLE""", file=f)
+	for fn in hot + [fn for (rt, fn, ag) in cold]:
+		print("#define " + fn + " gl_dispatch." + fn, file=f)
+	print("#endif", file=f)
+	for (ext, rt, fn, ag) in ext_functions:
+		print("#define " + fn + " gl_dispatch." + fn, file=f)
 
 
 with open("GL.cpp", "w") as f:
@@ -160,20 +310,55 @@ with open("GL.cpp", "w") as f:
 #include <SDL.h>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <unordered_set>
 
-#ifdef _WIN32
-	#define DO(fn) \\
-		fn = (decltype(fn))SDL_GL_GetProcAddress(#fn); \\
-		if (!fn) { \\
-			throw std::runtime_error("Error binding " #fn); \\
-		}
+GLDispatch gl_dispatch;
+GLExtensions gl_extensions;
+
+//core entry points: every one with the dispatch table, 1.2+ on Windows otherwise
+// (with the table, 'fn' expands to its gl_dispatch entry, so the name is stringized
+//  before 'fn' is passed on -- '#fn' inside BIND would see the expansion):
+#define BIND(fn, name) \\
+	fn = (decltype(fn))SDL_GL_GetProcAddress(name); \\
+	if (!fn) { \\
+		throw std::runtime_error("Error binding " name); \\
+	}
+#if defined(GL_DISPATCH_TABLE) || defined(_WIN32)
+	#define DO(fn) BIND(fn, #fn)
 #else
 	#define DO(fn)
 #endif
+#ifdef GL_DISPATCH_TABLE
+	#define DO_1_1(fn) BIND(fn, #fn)
+#else
+	#define DO_1_1(fn)
+#endif
+
+//extension entry points (allowed to be missing; 'fn' always expands to its gl_dispatch entry):
+#define EXT(fn) \\
+	fn = (decltype(fn))SDL_GL_GetProcAddress(#fn);
 
 void init_GL() {""", file=f)
-	print("\t" + "\n\t".join(lookups),file=f)
+	print("\t" + "\n\t".join("DO_1_1(" + fn + ")" for (rt, fn, ag, proto) in core_functions if proto), file=f)
+	print("\t" + "\n\t".join(lookups), file=f)
+	print("""
+	//extensions -- listed once, checked once:
+	std::unordered_set< std::string > available;
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (GLint i = 0; i < count; ++i) {
+		if (GLubyte const *name = glGetStringi(GL_EXTENSIONS, GLuint(i))) {
+			available.emplace(reinterpret_cast< char const * >(name));
+		}
+	}""", file=f)
+	for (ext, functions, tokens, types) in EXTENSIONS:
+		print("\tif (available.count(\"" + ext + "\")) {", file=f)
+		for fn in functions:
+			print("\t\tEXT(" + fn + ")", file=f)
+		print("\t\tgl_extensions." + ext[3:] + " = " + " && ".join("(" + fn + " != nullptr)" for fn in functions) + ";", file=f)
+		print("\t}", file=f)
 	print("""}
-#ifdef _WIN32""", file=f)
+#if defined(_WIN32) && !defined(GL_DISPATCH_TABLE)""", file=f)
 	print("\t" + "\n\t".join(fps),file=f)
 	print("""#endif""", file=f)
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Helpers for reading and writing "chunks" of tightly-packed data:
+ *  [ magic (4 chars) | size in bytes (uint32) | data ... ]
+ *
+ * Data is copied in bulk, so element types must be trivially copyable and
+ *  contain no padding. Files are little-endian; these helpers refuse to run
+ *  on a big-endian host rather than silently producing byte-swapped files.
+ */
+
+inline void check_little_endian() {
+	uint32_t one = 1;
+	uint8_t first = 0;
+	std::memcpy(&first, &one, 1);
+	if (first != 1) {
+		throw std::runtime_error("read/write_chunk only supports little-endian hosts");
+	}
+}
+
+template< typename T >
+void read_chunk(std::istream &from, std::string const &magic, std::vector< T > *to_) {
+	assert(to_);
+	assert(magic.size() == 4);
+	check_little_endian();
+	auto &to = *to_;
+
+	struct ChunkHeader {
+		char magic[4] = {'\0', '\0', '\0', '\0'};
+		uint32_t size = 0;
+	};
+	static_assert(sizeof(ChunkHeader) == 8, "header is packed");
+
+	ChunkHeader header;
+	if (!from.read(reinterpret_cast< char * >(&header), sizeof(header))) {
+		throw std::runtime_error("Failed to read chunk header");
+	}
+	if (std::string(header.magic, 4) != magic) {
+		throw std::runtime_error("Unexpected magic number in chunk (expected '" + magic + "')");
+	}
+	if (header.size % sizeof(T) != 0) {
+		throw std::runtime_error("Size of chunk '" + magic + "' not divisible by element size");
+	}
+
+	to.resize(header.size / sizeof(T));
+	if (header.size && !from.read(reinterpret_cast< char * >(to.data()), header.size)) {
+		throw std::runtime_error("Failed to read chunk '" + magic + "' data");
+	}
+}
+
+template< typename T >
+void write_chunk(std::string const &magic, std::vector< T > const &from, std::ostream *to_) {
+	assert(to_);
+	assert(magic.size() == 4);
+	check_little_endian();
+	auto &to = *to_;
+
+	struct ChunkHeader {
+		char magic[4] = {'\0', '\0', '\0', '\0'};
+		uint32_t size = 0;
+	};
+	static_assert(sizeof(ChunkHeader) == 8, "header is packed");
+
+	ChunkHeader header;
+	header.magic[0] = magic[0];
+	header.magic[1] = magic[1];
+	header.magic[2] = magic[2];
+	header.magic[3] = magic[3];
+	header.size = uint32_t(from.size() * sizeof(T));
+
+	to.write(reinterpret_cast< const char * >(&header), sizeof(header));
+	to.write(reinterpret_cast< const char * >(from.data()), from.size() * sizeof(T));
+}